@@ -0,0 +1,293 @@
+#include "fixture_file_source.hpp"
+#include "locations.hpp"
+#include "util.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/platform/log.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/metrics.hpp>
+
+namespace po = boost::program_options;
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+
+using namespace mbgl;
+
+namespace {
+
+// Renders on the main thread whenever the map asks for a frame, like a platform view does,
+// and remembers whether the last frame showed the map fully loaded.
+class BenchView : public HeadlessView {
+public:
+    using HeadlessView::HeadlessView;
+
+    void invalidate() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            invalidated = true;
+        }
+        changed.notify_one();
+    }
+
+    // Waits until the map asks for a frame. Returns false if it didn't within the timeout.
+    bool waitForInvalidate(Duration timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!changed.wait_for(lock, timeout, [this] { return invalidated; })) {
+            return false;
+        }
+        invalidated = false;
+        return true;
+    }
+
+    void notifyMapChange(MapChange change) override {
+        // The map reports MapChangeDidFinishRenderingMapFullyRendered for the first complete
+        // frame after partial ones. A camera change that only shows loaded tiles renders no
+        // partial frame, so a fully rendered frame counts as well.
+        if (change == MapChangeDidFinishRenderingFrame) {
+            fullyRendered = false;
+        } else if (change == MapChangeDidFinishRenderingFrameFullyRendered ||
+                   change == MapChangeDidFinishRenderingMapFullyRendered) {
+            fullyRendered = true;
+        }
+    }
+
+    bool fullyRendered = false;
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool invalidated = false;
+};
+
+struct Step {
+    enum Kind : uint8_t { Jump, Fit, Rotate, KindCount };
+
+    static const char* kindName(Kind kind) {
+        switch (kind) {
+        case Jump: return "setLatLngZoom";
+        case Fit: return "fitBounds";
+        case Rotate: return "rotate";
+        default: return "";
+        }
+    }
+
+    Kind kind;
+    std::string name;
+    std::function<void (Map&)> apply;
+};
+
+// Jumps to each benchmark location, then zooms out by about a level to an area around it,
+// then turns the map by a quarter.
+std::vector<Step> makeScript() {
+    std::vector<Step> script;
+    for (const auto& location : bench::locations) {
+        const LatLng center { location.latitude, location.longitude };
+        const double span = 360.0 / std::pow(2.0, location.zoom);
+
+        script.push_back({ Step::Jump, location.name, [=](Map& map) {
+            map.setLatLngZoom(center, location.zoom);
+            map.setBearing(location.bearing);
+        }});
+        script.push_back({ Step::Fit, location.name, [=](Map& map) {
+            const LatLngBounds bounds { { center.latitude - span / 2, center.longitude - span },
+                                        { center.latitude + span / 2, center.longitude + span } };
+            map.fitBounds(bounds, EdgeInsets());
+        }});
+        script.push_back({ Step::Rotate, location.name, [=](Map& map) {
+            map.setBearing(location.bearing + 90);
+        }});
+    }
+    return script;
+}
+
+struct Measurement {
+    double time; // milliseconds from the camera change to the first fully rendered frame
+    uint32_t partialFrames;
+    uint64_t parses;
+    uint64_t uploads;
+};
+
+const Duration loadTimeout = std::chrono::seconds(30);
+
+uint64_t parseCount() {
+    const auto histograms = metrics::snapshot().histograms;
+    const auto it = histograms.find("worker.parse_time_us");
+    return it != histograms.end() ? it->second.count : 0;
+}
+
+// Renders the frames the map asks for until it is fully rendered. Returns the number of
+// frames that weren't, and adds up the uploads of all frames.
+uint32_t renderUntilLoaded(Map& map, BenchView& view, uint64_t& uploads) {
+    uint32_t partialFrames = 0;
+    while (true) {
+        if (!view.waitForInvalidate(loadTimeout)) {
+            throw std::runtime_error("the map didn't finish loading");
+        }
+        map.renderSync();
+        uploads += map.getLastFrameStats().uploads;
+        if (view.fullyRendered) {
+            return partialFrames;
+        }
+        partialFrames++;
+    }
+}
+
+// Renders the remaining frames, e.g. of fading labels, until the map stops asking for
+// frames, so that they aren't attributed to the next step.
+void settle(Map& map, BenchView& view) {
+    while (view.waitForInvalidate(std::chrono::milliseconds(100))) {
+        map.renderSync();
+    }
+}
+
+std::vector<Measurement> runScript(FileSource& fileSource, const std::string& styleJSON, const std::vector<Step>& script,
+                                   int width, int height, double pixelRatio) {
+    // A new map for every run, so that no run benefits from tiles loaded by the previous one.
+    BenchView view(pixelRatio, width, height);
+    Map map(view, fileSource, MapMode::Continuous);
+    map.setStyleJSON(styleJSON, "");
+
+    uint64_t uploads = 0;
+    renderUntilLoaded(map, view, uploads);
+    settle(map, view);
+
+    std::vector<Measurement> measurements;
+    for (const auto& step : script) {
+        const uint64_t parsesBefore = parseCount();
+        uploads = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        step.apply(map);
+        uint32_t partialFrames;
+        try {
+            partialFrames = renderUntilLoaded(map, view, uploads);
+        } catch (std::exception& e) {
+            throw std::runtime_error(std::string(Step::kindName(step.kind)) + " at \"" + step.name + "\": " + e.what());
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        measurements.push_back({ elapsed.count(), partialFrames, parseCount() - parsesBefore, uploads });
+        settle(map, view);
+    }
+    return measurements;
+}
+
+void writeSummary(bench::JSONWriter& writer, const std::vector<const Measurement*>& measurements) {
+    std::vector<double> times;
+    double partialFrames = 0, parses = 0, uploads = 0;
+    for (const auto measurement : measurements) {
+        times.push_back(measurement->time);
+        partialFrames += measurement->partialFrames;
+        parses += measurement->parses;
+        uploads += measurement->uploads;
+    }
+    std::sort(times.begin(), times.end());
+    const double count = measurements.size();
+
+    writer.StartObject();
+    writer.String("count");
+    writer.Int(int(measurements.size()));
+    bench::writeTimes(writer, times);
+    writer.String("partialFrames");
+    writer.Double(partialFrames / count);
+    writer.String("parses");
+    writer.Double(parses / count);
+    writer.String("uploads");
+    writer.Double(uploads / count);
+    writer.EndObject();
+}
+
+std::string toJSON(const std::vector<Step>& script, const std::vector<std::vector<Measurement>>& runs,
+                   int width, int height, double pixelRatio) {
+    rapidjson::StringBuffer buffer;
+    bench::JSONWriter writer(buffer);
+
+    writer.StartObject();
+    writer.String("width");
+    writer.Int(width);
+    writer.String("height");
+    writer.Int(height);
+    writer.String("pixelRatio");
+    writer.Double(pixelRatio);
+    writer.String("runs");
+    writer.Int(int(runs.size()));
+
+    // Times are in milliseconds. Frame, parse and upload counts are means per step.
+    std::vector<const Measurement*> all;
+    for (uint8_t kind = 0; kind < Step::KindCount; kind++) {
+        std::vector<const Measurement*> ofKind;
+        for (const auto& run : runs) {
+            for (std::size_t i = 0; i < script.size(); i++) {
+                if (script[i].kind == kind) {
+                    ofKind.push_back(&run[i]);
+                }
+            }
+        }
+        writer.String(Step::kindName(Step::Kind(kind)));
+        writeSummary(writer, ofKind);
+        all.insert(all.end(), ofKind.begin(), ofKind.end());
+    }
+    writer.String("all");
+    writeSummary(writer, all);
+
+    writer.EndObject();
+
+    return { buffer.GetString(), buffer.Size() };
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string assets = "ios/benchmark/assets";
+    std::string style = "styles/mapbox-streets-v7.json";
+    std::string output;
+    int width = 1024;
+    int height = 768;
+    double pixelRatio = 1.0;
+    int runs = 3;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("assets,a", po::value(&assets)->value_name("directory")->default_value(assets), "Directory that asset:// URLs are loaded from")
+        ("style,s", po::value(&style)->value_name("path")->default_value(style), "Style, relative to the asset directory")
+        ("width,w", po::value(&width)->value_name("pixels")->default_value(width), "Image width")
+        ("height,h", po::value(&height)->value_name("pixels")->default_value(height), "Image height")
+        ("ratio,r", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Pixel ratio")
+        ("runs", po::value(&runs)->value_name("count")->default_value(runs), "Number of times the camera script is run")
+        ("output,o", po::value(&output)->value_name("file"), "Write the JSON results to this file instead of stdout")
+    ;
+
+    if (!bench::parseOptions(argc, argv, desc)) {
+        return 1;
+    }
+
+    if (runs <= 0) {
+        std::cerr << "Error: at least one run is required" << std::endl;
+        return 1;
+    }
+
+    FixtureFileSource fileSource(assets);
+    const std::vector<Step> script = makeScript();
+
+    std::vector<std::vector<Measurement>> results;
+    try {
+        const std::string styleJSON = util::read_file(assets + "/" + style);
+        for (int i = 0; i < runs; i++) {
+            Log::Info(Event::General, "Running the camera script (%d/%d)", i + 1, runs);
+            results.push_back(runScript(fileSource, styleJSON, script, width, height, pixelRatio));
+        }
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    bench::writeOutput(toJSON(script, results, width, height, pixelRatio), output);
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "fixture_file_source.hpp"
+
+#include <mbgl/storage/request.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/url.hpp>
+
+namespace mbgl {
+
+class FixtureFileSource::Impl {
+public:
+    Impl(const std::string& root_) : root(root_) {}
+
+    void handleRequest(Request* req) const {
+        const std::string& url = req->resource.url;
+        const std::string path = url.compare(0, 8, "asset://") == 0
+            ? root + "/" + util::percentDecode(url.substr(8))
+            : url;
+
+        auto res = std::make_shared<Response>();
+        try {
+            res->data = util::read_file(path);
+            res->status = Response::Successful;
+        } catch (const std::exception& ex) {
+            res->status = Response::Error;
+            res->message = ex.what();
+        }
+
+        req->notify(res);
+    }
+
+    void cancelRequest(Request* req) const {
+        // Requests are answered as soon as they arrive, so there is nothing to abort.
+        req->destruct();
+    }
+
+private:
+    const std::string root;
+};
+
+FixtureFileSource::FixtureFileSource(const std::string& root)
+    : thread(std::make_unique<util::Thread<Impl>>(util::ThreadContext{"FileSource", util::ThreadType::Unknown, util::ThreadPriority::Low}, root)) {
+}
+
+FixtureFileSource::~FixtureFileSource() = default;
+
+Request* FixtureFileSource::request(const Resource& resource, uv_loop_t* loop, Callback callback) {
+    Request* req = new Request(resource, loop, std::move(callback));
+    thread->invoke(&Impl::handleRequest, req);
+    return req;
+}
+
+void FixtureFileSource::cancel(Request* req) {
+    req->cancel();
+    thread->invoke(&Impl::cancelRequest, req);
+}
+
+}
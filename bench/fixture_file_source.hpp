@@ -0,0 +1,32 @@
+#ifndef MBGL_BENCH_FIXTURE_FILE_SOURCE
+#define MBGL_BENCH_FIXTURE_FILE_SOURCE
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/thread.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+// Answers every request from files below a local directory, so that benchmark results don't
+// depend on the network or on the state of a cache. asset:// URLs are resolved against the
+// directory; other URLs are treated as paths. Missing files are reported as errors.
+class FixtureFileSource : public FileSource {
+public:
+    class Impl;
+
+    FixtureFileSource(const std::string& root);
+    ~FixtureFileSource() override;
+
+    // FileSource implementation.
+    Request* request(const Resource&, uv_loop_t*, Callback) override;
+    void cancel(Request*) override;
+
+private:
+    const std::unique_ptr<util::Thread<Impl>> thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "fixture_file_source.hpp"
+#include "locations.hpp"
+#include "util.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/platform/log.hpp>
+#include <mbgl/util/io.hpp>
+
+namespace po = boost::program_options;
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace mbgl;
+
+namespace {
+
+struct Result {
+    std::string name;
+    std::vector<double> frameTimes; // milliseconds, sorted
+    double fps;
+};
+
+std::string toJSON(const std::vector<Result>& results, int width, int height, double pixelRatio, int frames) {
+    rapidjson::StringBuffer buffer;
+    bench::JSONWriter writer(buffer);
+
+    writer.StartObject();
+    writer.String("width");
+    writer.Int(width);
+    writer.String("height");
+    writer.Int(height);
+    writer.String("pixelRatio");
+    writer.Double(pixelRatio);
+    writer.String("frames");
+    writer.Int(frames);
+
+    writer.String("locations");
+    writer.StartArray();
+    for (const auto& result : results) {
+        writer.StartObject();
+        writer.String("name");
+        writer.String(result.name.c_str(), result.name.size());
+        writer.String("fps");
+        writer.Double(result.fps);
+        bench::writeTimes(writer, result.frameTimes);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return { buffer.GetString(), buffer.Size() };
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string assets = "ios/benchmark/assets";
+    std::string style = "styles/mapbox-streets-v7.json";
+    std::string output;
+    int width = 1024;
+    int height = 768;
+    double pixelRatio = 1.0;
+    int warmup = 20;
+    int frames = 200;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("assets,a", po::value(&assets)->value_name("directory")->default_value(assets), "Directory that asset:// URLs are loaded from")
+        ("style,s", po::value(&style)->value_name("path")->default_value(style), "Style, relative to the asset directory")
+        ("width,w", po::value(&width)->value_name("pixels")->default_value(width), "Image width")
+        ("height,h", po::value(&height)->value_name("pixels")->default_value(height), "Image height")
+        ("ratio,r", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Pixel ratio")
+        ("warmup", po::value(&warmup)->value_name("frames")->default_value(warmup), "Untimed frames per location")
+        ("frames", po::value(&frames)->value_name("frames")->default_value(frames), "Timed frames per location")
+        ("output,o", po::value(&output)->value_name("file"), "Write the JSON results to this file instead of stdout")
+    ;
+
+    if (!bench::parseOptions(argc, argv, desc)) {
+        return 1;
+    }
+
+    if (frames <= 0) {
+        std::cerr << "Error: at least one frame must be timed" << std::endl;
+        return 1;
+    }
+
+    FixtureFileSource fileSource(assets);
+    HeadlessView view(pixelRatio, width, height);
+    Map map(view, fileSource, MapMode::Still);
+
+    try {
+        map.setStyleJSON(util::read_file(assets + "/" + style), "");
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (const auto& location : bench::locations) {
+        Log::Info(Event::General, "Benchmarking \"%s\"", location.name.c_str());
+
+        map.setLatLngZoom({ location.latitude, location.longitude }, location.zoom);
+        map.setBearing(location.bearing);
+
+        Result result { location.name, {}, 0 };
+        try {
+            // The first frame loads all resources of the location. Warm-up frames are not
+            // timed either, so that the numbers only reflect rendering and readback.
+            bench::renderOnce(map);
+            for (int i = 0; i < warmup; i++) {
+                bench::renderOnce(map);
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            for (int i = 0; i < frames; i++) {
+                const auto start = std::chrono::steady_clock::now();
+                bench::renderOnce(map);
+                const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                result.frameTimes.push_back(elapsed.count());
+            }
+            const std::chrono::duration<double> total = std::chrono::steady_clock::now() - started;
+            result.fps = frames / total.count();
+        } catch (std::exception& e) {
+            std::cerr << "Error at \"" << location.name << "\": " << e.what() << std::endl;
+            return 1;
+        }
+
+        std::sort(result.frameTimes.begin(), result.frameTimes.end());
+        results.push_back(std::move(result));
+    }
+
+    bench::writeOutput(toJSON(results, width, height, pixelRatio, frames), output);
+
+    return 0;
+}
@@ -0,0 +1,572 @@
+#include "fixture_file_source.hpp"
+#include "util.hpp"
+
+#include <mbgl/geometry/elements_buffer.hpp>
+#include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/geometry/glyph_atlas.hpp>
+#include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/geometry/sprite_atlas.hpp>
+#include <mbgl/annotation/sprite_store.hpp>
+#include <mbgl/map/sprite.hpp>
+#include <mbgl/map/vector_tile.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/renderer/symbol_bucket.hpp>
+#include <mbgl/style/filter_expression.hpp>
+#include <mbgl/style/style_parser.hpp>
+#include <mbgl/style/value.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/text/glyph_store.hpp>
+#include <mbgl/util/allocation_stats.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/merge_lines.hpp>
+#include <mbgl/util/pbf.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
+#include <mbgl/util/utf.hpp>
+
+#include <rapidjson/document.h>
+
+namespace po = boost::program_options;
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <regex>
+
+using namespace mbgl;
+
+#ifdef MBGL_ALLOCATION_STATS
+
+// The core library replaces operator new in this configuration. Benchmarks run on the main
+// thread, which counts into these.
+namespace {
+
+allocation::Counters mainThreadAllocations;
+
+uint64_t allocationCount() {
+    return mainThreadAllocations.total().allocations;
+}
+
+}
+
+#else
+
+namespace {
+
+std::atomic<uint64_t> allocations { 0 };
+
+uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+}
+
+// Every allocation of the process goes through these, so that the benchmarks can report how
+// many allocations an operation needs. Array and nothrow forms forward to these by default.
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Measures time and allocations of the iterations of a benchmark. Work that only restores the
+// input for the next iteration is excluded with pause() and resume().
+class State {
+public:
+    void pause() {
+        elapsed += Clock::now() - start;
+        allocations += allocationCount() - startAllocations;
+    }
+
+    void resume() {
+        startAllocations = allocationCount();
+        start = Clock::now();
+    }
+
+    Clock::duration elapsed = Clock::duration::zero();
+    uint64_t allocations = 0;
+
+private:
+    Clock::time_point start;
+    uint64_t startAllocations = 0;
+};
+
+struct Benchmark {
+    std::string name;
+    // What the benchmark processes, e.g. "feature". Results are reported per unit.
+    std::string unit;
+    // Runs one iteration and returns the number of units it processed.
+    std::function<std::size_t (State&)> run;
+};
+
+struct Result {
+    std::string name;
+    std::string unit;
+    std::size_t iterations;
+    std::size_t units;
+    double nsPerUnit;
+    double allocationsPerUnit;
+};
+
+Result measure(const Benchmark& benchmark, std::chrono::milliseconds minTime) {
+    // The untimed first iteration fills caches and lazily initialized state.
+    State warmup;
+    warmup.resume();
+    benchmark.run(warmup);
+
+    State state;
+    std::size_t iterations = 0;
+    std::size_t units = 0;
+    do {
+        state.resume();
+        units += benchmark.run(state);
+        state.pause();
+        iterations++;
+    } while (state.elapsed < minTime);
+
+    const double ns = std::chrono::duration<double, std::nano>(state.elapsed).count();
+    return {
+        benchmark.name,
+        benchmark.unit,
+        iterations,
+        units / iterations,
+        units ? ns / units : 0,
+        units ? double(state.allocations) / units : 0
+    };
+}
+
+pbf tilePBF(const std::string& data) {
+    return pbf(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+}
+
+// The source layers of the Mapbox Streets v6 tiles in test/fixtures/tiles/streets.
+const std::vector<std::string> streetsLayers = {
+    "landuse", "waterway", "water", "barrier_line", "building", "tunnel", "road", "bridge", "admin",
+    "place_label", "water_label", "poi_label", "road_label", "waterway_label", "housenum_label",
+};
+
+struct FixtureTile {
+    float zoom;
+    std::string data;
+    std::unique_ptr<VectorTile> tile;
+};
+
+// Returns the features of the given source layers of all tiles.
+std::vector<util::ptr<const GeometryTileFeature>> getFeatures(const std::vector<FixtureTile>& tiles,
+                                                              const std::vector<std::string>& layerNames) {
+    std::vector<util::ptr<const GeometryTileFeature>> result;
+    for (const auto& tile : tiles) {
+        for (const auto& name : layerNames) {
+            auto layer = tile.tile->getLayer(name);
+            for (std::size_t i = 0; layer && i < layer->featureCount(); i++) {
+                result.push_back(layer->getFeature(i));
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<GeometryCollection> getGeometries(const std::vector<FixtureTile>& tiles,
+                                              const std::vector<std::string>& layerNames,
+                                              FeatureType type) {
+    std::vector<GeometryCollection> result;
+    for (const auto& feature : getFeatures(tiles, layerNames)) {
+        if (feature->getType() == type) {
+            result.push_back(feature->getGeometries());
+        }
+    }
+    return result;
+}
+
+std::string getString(const GeometryTileFeature& feature, const std::string& key) {
+    auto value = feature.getValue(key);
+    return value ? toString(*value) : std::string();
+}
+
+// Decodes the wire format of all layers and features, including the packed tags and
+// geometries, without building any objects. Returns the number of features.
+std::size_t decodeTile(const std::string& data, std::vector<uint32_t>& values) {
+    std::size_t features = 0;
+    pbf tile = tilePBF(data);
+    while (tile.next(3)) { // layer
+        pbf layer = tile.message();
+        while (layer.next()) {
+            if (layer.tag == 2) { // feature
+                pbf feature = layer.message();
+                while (feature.next()) {
+                    if (feature.tag == 2 || feature.tag == 4) { // tags, geometry
+                        feature.message().packedVarints(values);
+                    } else if (feature.tag == 3) { // type
+                        feature.varint();
+                    } else {
+                        feature.skip();
+                    }
+                }
+                features++;
+            } else {
+                layer.skip();
+            }
+        }
+    }
+    return features;
+}
+
+struct SymbolLayer {
+    std::string sourceLayer;
+    PlacementType placement;
+    std::string field;
+};
+
+const std::vector<SymbolLayer> symbolLayers = {
+    { "poi_label", PlacementType::Point, "{name}" },
+    { "housenum_label", PlacementType::Point, "{house_num}" },
+    { "road_label", PlacementType::Line, "{name}" },
+};
+
+void configure(SymbolBucket& bucket, const SymbolLayer& layer) {
+    bucket.layout.placement = layer.placement;
+    bucket.layout.text.field = layer.field;
+    if (layer.placement == PlacementType::Line) {
+        bucket.layout.icon.rotation_alignment = RotationAlignmentType::Map;
+        bucket.layout.text.rotation_alignment = RotationAlignmentType::Map;
+    }
+}
+
+class GlyphObserver : public GlyphStore::Observer {
+public:
+    void onGlyphRangeLoaded() override {}
+    void onGlyphRangeLoadingFailed(std::exception_ptr error_) override {
+        error = error_;
+    }
+
+    std::exception_ptr error;
+};
+
+// Loads the glyph ranges that the labels of the tiles need, so that SymbolBucket::addFeatures
+// finds every font stack it shapes text with.
+void loadGlyphs(const std::vector<FixtureTile>& tiles, GlyphStore& glyphStore, Sprite& sprite) {
+    GlyphObserver observer;
+    glyphStore.setObserver(&observer);
+
+    CollisionTile collision(0, 4096, 512, 0, false);
+    for (const auto& tile : tiles) {
+        for (const auto& layer : symbolLayers) {
+            auto geometryLayer = tile.tile->getLayer(layer.sourceLayer);
+            if (!geometryLayer) {
+                continue;
+            }
+
+            while (true) {
+                SymbolBucket bucket(collision, 1);
+                configure(bucket, layer);
+                if (!bucket.needsDependencies(*geometryLayer, FilterExpression(), glyphStore, sprite)) {
+                    break;
+                }
+                if (!uv_run(util::RunLoop::getLoop(), UV_RUN_ONCE) && !observer.error) {
+                    throw std::runtime_error("glyph ranges did not load");
+                }
+                if (observer.error) {
+                    std::rethrow_exception(observer.error);
+                }
+            }
+        }
+    }
+
+    glyphStore.setObserver(nullptr);
+}
+
+// Sink for results that the benchmarks compute only to keep the compiler from removing the work.
+volatile std::size_t sink = 0;
+
+std::vector<Benchmark> createBenchmarks(const std::vector<FixtureTile>& tiles,
+                                        std::shared_ptr<const rapidjson::Document> style,
+                                        GlyphStore& glyphStore,
+                                        Sprite& sprite,
+                                        SpriteAtlas& spriteAtlas,
+                                        GlyphAtlas& glyphAtlas) {
+    std::vector<Benchmark> benchmarks;
+
+    std::size_t featureCount = 0;
+    for (const auto& tile : tiles) {
+        std::vector<uint32_t> values;
+        featureCount += decodeTile(tile.data, values);
+    }
+
+    benchmarks.push_back({ "pbf", "feature", [&tiles](State&) {
+        std::vector<uint32_t> values;
+        std::size_t features = 0;
+        for (const auto& tile : tiles) {
+            features += decodeTile(tile.data, values);
+        }
+        return features;
+    }});
+
+    benchmarks.push_back({ "VectorTile", "feature", [&tiles, featureCount](State&) {
+        for (const auto& tile : tiles) {
+            VectorTile vectorTile(tilePBF(tile.data));
+        }
+        return featureCount;
+    }});
+
+    auto features = std::make_shared<std::vector<util::ptr<const GeometryTileFeature>>>(
+        getFeatures(tiles, streetsLayers));
+    auto filters = std::make_shared<std::vector<FilterExpression>>();
+    for (const char* json : {
+        R"(["==", "$type", "Polygon"])",
+        R"(["in", "class", "motorway", "main", "street", "street_limited", "service"])",
+        R"(["all", ["==", "$type", "LineString"], ["!in", "type", "tunnel", "bridge"]])",
+        R"(["any", ["<=", "scalerank", 2], ["==", "maki", "park"]])",
+    }) {
+        rapidjson::Document doc;
+        doc.Parse<0>(json);
+        filters->push_back(parseFilterExpression(doc));
+    }
+
+    benchmarks.push_back({ "filter", "evaluation", [features, filters](State&) {
+        std::size_t matches = 0;
+        for (const auto& feature : *features) {
+            GeometryTileFeatureExtractor extractor(*feature);
+            for (const auto& filter : *filters) {
+                matches += evaluate(filter, extractor);
+            }
+        }
+        sink = matches;
+        return features->size() * filters->size();
+    }});
+
+    auto polygons = std::make_shared<std::vector<GeometryCollection>>(
+        getGeometries(tiles, { "landuse", "water", "building" }, FeatureType::Polygon));
+
+    benchmarks.push_back({ "FillBucket", "polygon", [polygons](State&) {
+        FillVertexBuffer vertexBuffer;
+        TriangleElementsBuffer triangleElementsBuffer;
+        LineElementsBuffer lineElementsBuffer;
+        FillBucket bucket(vertexBuffer, triangleElementsBuffer, lineElementsBuffer);
+        for (const auto& polygon : *polygons) {
+            bucket.addGeometry(polygon);
+        }
+        return polygons->size();
+    }});
+
+    auto lines = std::make_shared<std::vector<GeometryCollection>>(
+        getGeometries(tiles, { "road", "tunnel", "bridge", "barrier_line", "waterway", "admin" }, FeatureType::LineString));
+
+    benchmarks.push_back({ "LineBucket", "line", [lines](State&) {
+        LineVertexBuffer vertexBuffer;
+        TriangleElementsBuffer triangleElementsBuffer;
+        LineBucket bucket(vertexBuffer, triangleElementsBuffer);
+        bucket.layout.join = JoinType::Round;
+        bucket.layout.cap = CapType::Round;
+        for (const auto& line : *lines) {
+            bucket.addGeometry(line);
+        }
+        return lines->size();
+    }});
+
+    benchmarks.push_back({ "SymbolBucket", "feature", [&](State& state) {
+        const uintptr_t tileUID = 1;
+        std::size_t count = 0;
+        for (const auto& tile : tiles) {
+            CollisionTile collision(tile.zoom, 4096, 512, 0, false);
+            for (const auto& layer : symbolLayers) {
+                auto geometryLayer = tile.tile->getLayer(layer.sourceLayer);
+                if (!geometryLayer) {
+                    continue;
+                }
+
+                // needsDependencies() collects the labels of the features, addFeatures() shapes
+                // and places them, the same way TileWorker does.
+                SymbolBucket bucket(collision, 1);
+                configure(bucket, layer);
+                bucket.needsDependencies(*geometryLayer, FilterExpression(), glyphStore, sprite);
+                bucket.addFeatures(tileUID, spriteAtlas, glyphAtlas, glyphStore);
+                count += geometryLayer->featureCount();
+            }
+        }
+
+        // Like a newly parsed tile, the next iteration has to add its glyphs to the atlas again.
+        state.pause();
+        glyphAtlas.removeGlyphs(tileUID);
+        state.resume();
+
+        return count;
+    }});
+
+    auto collisionFeatures = std::make_shared<std::vector<CollisionFeature>>();
+    for (const auto& feature : getFeatures(tiles, { "place_label", "poi_label", "housenum_label" })) {
+        const GeometryCollection geometries = feature->getGeometries();
+        if (geometries.empty() || geometries.front().empty()) {
+            continue;
+        }
+
+        // A single line label of 16px text, roughly as wide as its name.
+        const Coordinate& point = geometries.front().front();
+        const float halfWidth = 4.0f * util::utf8_to_utf32::convert(getString(*feature, "name")).size();
+        const float boxScale = (4096.0f / 512.0f) * (16.0f / 24.0f);
+        collisionFeatures->emplace_back(geometries.front(), Anchor(point.x, point.y, 0, 0.5f),
+                                        -12.0f, 12.0f, -halfWidth, halfWidth, boxScale, 2.0f, false);
+    }
+
+    benchmarks.push_back({ "CollisionTile", "feature", [collisionFeatures](State&) {
+        CollisionTile collision(15, 4096, 512, 0, false);
+        for (auto& feature : *collisionFeatures) {
+            collision.insertFeature(feature, collision.placeFeature(feature));
+        }
+        return collisionFeatures->size();
+    }});
+
+    auto labels = std::make_shared<std::vector<SymbolFeature>>();
+    for (const auto& feature : getFeatures(tiles, { "road_label" })) {
+        SymbolFeature label;
+        label.label = util::utf8_to_utf32::convert(getString(*feature, "name"));
+        label.geometry = feature->getGeometries();
+        labels->push_back(std::move(label));
+    }
+    auto merged = std::make_shared<std::vector<SymbolFeature>>();
+
+    benchmarks.push_back({ "mergeLines", "feature", [labels, merged](State& state) {
+        // mergeLines() modifies its input, so every iteration starts from a fresh copy.
+        state.pause();
+        *merged = *labels;
+        state.resume();
+
+        util::mergeLines(*merged);
+        return labels->size();
+    }});
+
+    benchmarks.push_back({ "StyleParser", "layer", [style](State&) {
+        StyleParser parser;
+        parser.parse(*style);
+        return parser.getLayers().size();
+    }});
+
+    return benchmarks;
+}
+
+std::string toJSON(const std::vector<Result>& results) {
+    rapidjson::StringBuffer buffer;
+    bench::JSONWriter writer(buffer);
+
+    writer.StartArray();
+    for (const auto& result : results) {
+        writer.StartObject();
+        writer.String("name");
+        writer.String(result.name.c_str(), result.name.size());
+        writer.String("unit");
+        writer.String(result.unit.c_str(), result.unit.size());
+        writer.String("iterations");
+        writer.Uint64(result.iterations);
+        writer.String("units");
+        writer.Uint64(result.units);
+        writer.String("ns");
+        writer.Double(result.nsPerUnit);
+        writer.String("allocations");
+        writer.Double(result.allocationsPerUnit);
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    return { buffer.GetString(), buffer.Size() };
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string fixtures = "test/fixtures";
+    std::string style = "ios/benchmark/assets/styles/mapbox-streets-v7.json";
+    std::string filter;
+    std::string output;
+    int minTime = 500;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("fixtures", po::value(&fixtures)->value_name("directory")->default_value(fixtures), "Test fixture directory")
+        ("style,s", po::value(&style)->value_name("path")->default_value(style), "Style that StyleParser is measured with")
+        ("filter,f", po::value(&filter)->value_name("regex"), "Only run benchmarks whose name matches")
+        ("min-time,t", po::value(&minTime)->value_name("ms")->default_value(minTime), "Minimum timed duration per benchmark")
+        ("output,o", po::value(&output)->value_name("file"), "Also write the results as JSON to this file")
+    ;
+
+    if (!bench::parseOptions(argc, argv, desc)) {
+        return 1;
+    }
+
+#ifdef MBGL_ALLOCATION_STATS
+    const allocation::CountScope count(mainThreadAllocations);
+#endif
+
+    util::RunLoop loop(uv_default_loop());
+    FixtureFileSource fileSource(fixtures + "/resources");
+    util::ThreadContext::setFileSource(&fileSource);
+
+    GlyphStore glyphStore(loop.get());
+    glyphStore.setURL("asset://glyphs.pbf");
+    Sprite sprite("", 1);
+    SpriteStore spriteStore;
+    SpriteAtlas spriteAtlas(512, 512, 1, spriteStore);
+    GlyphAtlas glyphAtlas(1024, 1024);
+
+    std::vector<FixtureTile> tiles;
+    auto styleDocument = std::make_shared<rapidjson::Document>();
+    try {
+        for (const auto& name : { "0-0-0", "15-17605-10749", "15-17605-10750" }) {
+            FixtureTile tile { float(std::atoi(name)), util::read_file(fixtures + "/tiles/streets/" + name + ".vector.pbf"), nullptr };
+            tile.tile = std::make_unique<VectorTile>(tilePBF(tile.data));
+            tiles.push_back(std::move(tile));
+        }
+
+        const std::string json = util::read_file(style);
+        styleDocument->Parse<0>(json.c_str());
+        if (styleDocument->HasParseError()) {
+            throw std::runtime_error(std::string("invalid style: ") + styleDocument->GetParseError());
+        }
+
+        loadGlyphs(tiles, glyphStore, sprite);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    const std::regex pattern(filter);
+    std::vector<Result> results;
+
+    std::printf("%-16s %12s %12s %14s %14s\n", "benchmark", "iterations", "units", "ns/unit", "allocs/unit");
+    for (const auto& benchmark : createBenchmarks(tiles, styleDocument, glyphStore, sprite, spriteAtlas, glyphAtlas)) {
+        if (!filter.empty() && !std::regex_search(benchmark.name, pattern)) {
+            continue;
+        }
+
+        const Result result = measure(benchmark, std::chrono::milliseconds(minTime));
+        std::printf("%-16s %12zu %6zu %-5s %14.1f %14.2f\n", result.name.c_str(), result.iterations,
+                    result.units, result.unit.substr(0, 5).c_str(), result.nsPerUnit, result.allocationsPerUnit);
+        results.push_back(result);
+    }
+
+    if (!output.empty()) {
+        util::write_file(output, toJSON(results));
+    }
+
+    util::ThreadContext::setFileSource(nullptr);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "recording_file_source.hpp"
+
+#include <mbgl/storage/response.hpp>
+
+namespace mbgl {
+
+RecordingFileSource::RecordingFileSource(FileSource& source_)
+    : source(source_) {
+}
+
+Request* RecordingFileSource::request(const Resource& resource, uv_loop_t* loop, Callback callback) {
+    const TimePoint requested = Clock::now();
+    return source.request(resource, loop, [this, resource, requested, callback](const Response& res) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            recorded.entries.push_back({
+                resource.kind,
+                resource.url,
+                Clock::now() - requested,
+                std::make_shared<Response>(res)
+            });
+        }
+        callback(res);
+    });
+}
+
+void RecordingFileSource::cancel(Request* req) {
+    source.cancel(req);
+}
+
+ReplayArchive RecordingFileSource::archive() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recorded;
+}
+
+}
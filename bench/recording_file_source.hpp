@@ -0,0 +1,34 @@
+#ifndef MBGL_BENCH_RECORDING_FILE_SOURCE
+#define MBGL_BENCH_RECORDING_FILE_SOURCE
+
+#include "replay_archive.hpp"
+
+#include <mbgl/storage/file_source.hpp>
+
+#include <mutex>
+
+namespace mbgl {
+
+// Passes requests on to another file source, and records every response it delivers along
+// with the time it took, so that the load can be replayed by a ReplayFileSource.
+class RecordingFileSource : public FileSource {
+public:
+    RecordingFileSource(FileSource& source);
+
+    // FileSource implementation.
+    Request* request(const Resource&, uv_loop_t*, Callback) override;
+    void cancel(Request*) override;
+
+    // Returns the responses recorded so far.
+    ReplayArchive archive() const;
+
+private:
+    FileSource& source;
+
+    mutable std::mutex mutex;
+    ReplayArchive recorded;
+};
+
+}
+
+#endif
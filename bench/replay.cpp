@@ -0,0 +1,187 @@
+#include "recording_file_source.hpp"
+#include "replay_file_source.hpp"
+#include "locations.hpp"
+#include "util.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/platform/log.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <rapidjson/document.h>
+
+namespace po = boost::program_options;
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace mbgl;
+
+namespace {
+
+// Reads a camera path from a JSON array of objects with the members of bench::Location.
+std::vector<bench::Location> readPath(const std::string& path) {
+    rapidjson::Document document;
+    document.Parse<0>(util::read_file(path).c_str());
+    if (document.HasParseError() || !document.IsArray()) {
+        throw std::runtime_error(path + " is not a JSON array");
+    }
+
+    std::vector<bench::Location> locations;
+    for (rapidjson::SizeType i = 0; i < document.Size(); i++) {
+        const auto& value = document[i];
+        if (!value.IsObject() || !value.HasMember("name") || !value.HasMember("longitude") ||
+            !value.HasMember("latitude") || !value.HasMember("zoom")) {
+            throw std::runtime_error(path + ": locations need a name, longitude, latitude and zoom");
+        }
+        locations.push_back({
+            value["name"].GetString(),
+            value["longitude"].GetDouble(),
+            value["latitude"].GetDouble(),
+            value["zoom"].GetDouble(),
+            value.HasMember("bearing") ? value["bearing"].GetDouble() : 0.0
+        });
+    }
+    return locations;
+}
+
+// Loads the style and walks the camera path once, with a fresh map so that no tiles are
+// cached from a previous run. Returns the time until each location was fully loaded.
+std::vector<double> walk(FileSource& fileSource, const std::string& styleURL,
+                         const std::vector<bench::Location>& locations,
+                         int width, int height, double pixelRatio) {
+    HeadlessView view(pixelRatio, width, height);
+    Map map(view, fileSource, MapMode::Still);
+    map.setStyleURL(styleURL);
+
+    std::vector<double> times;
+    for (const auto& location : locations) {
+        map.setLatLngZoom({ location.latitude, location.longitude }, location.zoom);
+        map.setBearing(location.bearing);
+
+        // Rendering a still image loads every resource first, so this is the time until the
+        // map is fully loaded.
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            bench::renderOnce(map);
+        } catch (std::exception& e) {
+            throw std::runtime_error("at \"" + location.name + "\": " + e.what());
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        times.push_back(elapsed.count());
+    }
+    return times;
+}
+
+std::string toJSON(const std::vector<bench::Location>& locations, const std::vector<std::vector<double>>& runs,
+                   double latencyScale) {
+    rapidjson::StringBuffer buffer;
+    bench::JSONWriter writer(buffer);
+
+    writer.StartObject();
+    writer.String("latencyScale");
+    writer.Double(latencyScale);
+    writer.String("runs");
+    writer.Int(int(runs.size()));
+
+    writer.String("locations");
+    writer.StartArray();
+    for (std::size_t i = 0; i < locations.size(); i++) {
+        std::vector<double> times;
+        for (const auto& run : runs) {
+            times.push_back(run[i]);
+        }
+        std::sort(times.begin(), times.end());
+
+        writer.StartObject();
+        writer.String("name");
+        writer.String(locations[i].name.c_str(), locations[i].name.size());
+        bench::writeTimes(writer, times);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return { buffer.GetString(), buffer.Size() };
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string record;
+    std::string replay;
+    std::string assets = "ios/benchmark/assets";
+    std::string style = "asset://styles/mapbox-streets-v7.json";
+    std::string path;
+    std::string output;
+    int width = 1024;
+    int height = 768;
+    double pixelRatio = 1.0;
+    double latencyScale = 1.0;
+    int runs = 5;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("record", po::value(&record)->value_name("file"), "Load the camera path from the network and write an archive")
+        ("replay", po::value(&replay)->value_name("file"), "Load the camera path from an archive")
+        ("assets,a", po::value(&assets)->value_name("directory")->default_value(assets), "Directory that asset:// URLs are loaded from while recording")
+        ("style,s", po::value(&style)->value_name("url")->default_value(style), "Style URL")
+        ("path,p", po::value(&path)->value_name("file"), "JSON camera path; defaults to the benchmark locations")
+        ("width,w", po::value(&width)->value_name("pixels")->default_value(width), "Image width")
+        ("height,h", po::value(&height)->value_name("pixels")->default_value(height), "Image height")
+        ("ratio,r", po::value(&pixelRatio)->value_name("number")->default_value(pixelRatio), "Pixel ratio")
+        ("latency-scale", po::value(&latencyScale)->value_name("factor")->default_value(latencyScale), "Multiplies the recorded latencies when replaying")
+        ("runs", po::value(&runs)->value_name("count")->default_value(runs), "Number of times the camera path is replayed")
+        ("output,o", po::value(&output)->value_name("file"), "Write the JSON results to this file instead of stdout")
+    ;
+
+    if (!bench::parseOptions(argc, argv, desc)) {
+        return 1;
+    }
+
+    if (record.empty() == replay.empty()) {
+        std::cerr << "Error: pass either --record or --replay" << std::endl << desc;
+        return 1;
+    }
+    if (runs <= 0 || latencyScale < 0) {
+        std::cerr << "Error: at least one run and a non-negative latency scale are required" << std::endl;
+        return 1;
+    }
+
+    try {
+        const std::vector<bench::Location> locations = path.empty() ? bench::locations : readPath(path);
+
+        if (!record.empty()) {
+            // Without a cache, so that the recorded latencies are those of the network.
+            DefaultFileSource network(nullptr, assets);
+            if (const char* token = getenv("MAPBOX_ACCESS_TOKEN")) {
+                network.setAccessToken(token);
+            }
+
+            RecordingFileSource recorder(network);
+            walk(recorder, style, locations, width, height, pixelRatio);
+
+            const ReplayArchive archive = recorder.archive();
+            archive.save(record);
+            Log::Info(Event::General, "Recorded %u responses", unsigned(archive.entries.size()));
+            return 0;
+        }
+
+        ReplayFileSource fileSource(ReplayArchive::load(replay), latencyScale);
+        std::vector<std::vector<double>> results;
+        for (int i = 0; i < runs; i++) {
+            fileSource.rewind();
+            results.push_back(walk(fileSource, style, locations, width, height, pixelRatio));
+        }
+
+        bench::writeOutput(toJSON(locations, results, latencyScale), output);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
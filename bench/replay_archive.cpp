@@ -0,0 +1,109 @@
+#include "replay_archive.hpp"
+
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+// Bump the version when the layout of an entry changes.
+const std::string magic = "MBGLREC2";
+
+// Integers are stored little endian, so that archives can be exchanged between machines.
+void writeInt(std::string& out, uint64_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; i++) {
+        out.push_back(char((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void writeString(std::string& out, const std::string& value) {
+    writeInt(out, value.size(), 4);
+    out.append(value);
+}
+
+class Reader {
+public:
+    Reader(const std::string& data_) : data(data_) {}
+
+    uint64_t readInt(std::size_t bytes) {
+        require(bytes);
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; i++) {
+            value |= uint64_t(uint8_t(data[pos++])) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string readString() {
+        const std::size_t length = readInt(4);
+        require(length);
+        std::string value = data.substr(pos, length);
+        pos += length;
+        return value;
+    }
+
+    bool done() const {
+        return pos == data.size();
+    }
+
+private:
+    void require(std::size_t bytes) const {
+        if (data.size() - pos < bytes) {
+            throw std::runtime_error("replay archive is truncated");
+        }
+    }
+
+    const std::string& data;
+    std::size_t pos = 0;
+};
+
+}
+
+void ReplayArchive::save(const std::string& path) const {
+    std::string out = magic;
+    for (const auto& entry : entries) {
+        const Response& response = *entry.response;
+        writeInt(out, entry.kind, 1);
+        writeString(out, entry.url);
+        writeInt(out, std::chrono::duration_cast<std::chrono::microseconds>(entry.latency).count(), 8);
+        writeInt(out, response.status, 1);
+        writeInt(out, response.modified, 8);
+        writeInt(out, response.expires, 8);
+        writeString(out, response.etag);
+        writeString(out, response.message);
+        writeString(out, response.data);
+    }
+    util::write_file(path, out);
+}
+
+ReplayArchive ReplayArchive::load(const std::string& path) {
+    const std::string data = util::read_file(path);
+    if (data.compare(0, magic.size(), magic) != 0) {
+        throw std::runtime_error(path + " is not a replay archive");
+    }
+
+    Reader reader(data);
+    reader.readInt(magic.size());
+
+    ReplayArchive archive;
+    while (!reader.done()) {
+        const auto kind = Resource::Kind(reader.readInt(1));
+        std::string url = reader.readString();
+        const Duration latency = std::chrono::microseconds(reader.readInt(8));
+
+        auto response = std::make_shared<Response>();
+        response->status = Response::Status(reader.readInt(1) != 0);
+        response->modified = int64_t(reader.readInt(8));
+        response->expires = int64_t(reader.readInt(8));
+        response->etag = reader.readString();
+        response->message = reader.readString();
+        response->data = reader.readString();
+
+        archive.entries.push_back({ kind, std::move(url), latency, std::move(response) });
+    }
+    return archive;
+}
+
+}
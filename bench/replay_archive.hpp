@@ -0,0 +1,34 @@
+#ifndef MBGL_BENCH_REPLAY_ARCHIVE
+#define MBGL_BENCH_REPLAY_ARCHIVE
+
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Every response a RecordingFileSource received, in the order in which they arrived, stored
+// in a single file so that a load can be replayed without network access.
+class ReplayArchive {
+public:
+    struct Entry {
+        Resource::Kind kind;
+        std::string url;
+        Duration latency; // from the request to the response
+        std::shared_ptr<const Response> response;
+    };
+
+    std::vector<Entry> entries;
+
+    // Both throw std::runtime_error if the file can't be accessed or isn't an archive.
+    void save(const std::string& path) const;
+    static ReplayArchive load(const std::string& path);
+};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "replay_file_source.hpp"
+
+#include <mbgl/storage/request.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/uv_detail.hpp>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+// The timer always runs, so that it can be rearmed with uv_timer_again(). This is how long
+// it waits when no request is pending.
+const uint64_t idleTimeout = 1000000;
+
+}
+
+class ReplayFileSource::Impl {
+public:
+    Impl(const ReplayArchive& archive_, double latencyScale_)
+        : archive(archive_), latencyScale(latencyScale_), timer(util::RunLoop::getLoop()) {
+        for (const auto& entry : archive.entries) {
+            responses[entry.url].push_back(&entry);
+        }
+        timer.start(idleTimeout, idleTimeout, [this] { dispatchPendingRequests(); });
+        timer.unref();
+    }
+
+    ~Impl() {
+        timer.stop();
+    }
+
+    void handleRequest(Request* req) {
+        auto it = responses.find(req->resource.url);
+        if (it == responses.end()) {
+            auto res = std::make_shared<Response>();
+            res->status = Response::Error;
+            res->message = "Not in the replay archive";
+            req->notify(res);
+            return;
+        }
+
+        const auto& recorded = it->second;
+        std::size_t& next = nextResponse[it->first];
+        const ReplayArchive::Entry& entry = *recorded[next];
+        if (next + 1 < recorded.size()) {
+            next++;
+        }
+
+        const auto delay = std::chrono::duration_cast<Duration>(entry.latency * latencyScale);
+        if (delay <= Duration::zero()) {
+            req->notify(entry.response);
+            return;
+        }
+
+        pending.emplace(Clock::now() + delay, std::make_pair(req, entry.response));
+        rearm();
+    }
+
+    void rewind() {
+        nextResponse.clear();
+    }
+
+    void cancelRequest(Request* req) {
+        auto it = std::find_if(pending.begin(), pending.end(), [req](const auto& p) {
+            return p.second.first == req;
+        });
+        if (it != pending.end()) {
+            pending.erase(it);
+            rearm();
+        } else {
+            // The response was already delivered before the cancelation arrived.
+        }
+
+        req->destruct();
+    }
+
+private:
+    void dispatchPendingRequests() {
+        const TimePoint now = Clock::now();
+        while (!pending.empty() && pending.begin()->first <= now) {
+            auto p = pending.begin()->second;
+            pending.erase(pending.begin());
+            p.first->notify(p.second);
+        }
+        rearm();
+    }
+
+    // Schedules the timer for the earliest pending response.
+    void rearm() {
+        uint64_t timeout = idleTimeout;
+        if (!pending.empty()) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                pending.begin()->first - Clock::now() + std::chrono::microseconds(999));
+            timeout = std::max<int64_t>(1, remaining.count());
+        }
+        uv_timer_set_repeat(timer.get(), timeout);
+        uv_timer_again(timer.get());
+    }
+
+    const ReplayArchive archive;
+    const double latencyScale;
+    std::unordered_map<std::string, std::vector<const ReplayArchive::Entry*>> responses;
+    std::unordered_map<std::string, std::size_t> nextResponse;
+    std::multimap<TimePoint, std::pair<Request*, std::shared_ptr<const Response>>> pending;
+    uv::timer timer;
+};
+
+// The archive is copied to the file source thread, so that the caller may discard it.
+ReplayFileSource::ReplayFileSource(const ReplayArchive& archive, double latencyScale)
+    : thread(std::make_unique<util::Thread<Impl>>(util::ThreadContext{"FileSource", util::ThreadType::Unknown, util::ThreadPriority::Low}, archive, latencyScale)) {
+}
+
+ReplayFileSource::~ReplayFileSource() = default;
+
+Request* ReplayFileSource::request(const Resource& resource, uv_loop_t* loop, Callback callback) {
+    Request* req = new Request(resource, loop, std::move(callback));
+    thread->invoke(&Impl::handleRequest, req);
+    return req;
+}
+
+void ReplayFileSource::rewind() {
+    thread->invokeSync(&Impl::rewind);
+}
+
+void ReplayFileSource::cancel(Request* req) {
+    req->cancel();
+    thread->invoke(&Impl::cancelRequest, req);
+}
+
+}
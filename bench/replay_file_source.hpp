@@ -0,0 +1,38 @@
+#ifndef MBGL_BENCH_REPLAY_FILE_SOURCE
+#define MBGL_BENCH_REPLAY_FILE_SOURCE
+
+#include "replay_archive.hpp"
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/thread.hpp>
+
+#include <memory>
+
+namespace mbgl {
+
+// Answers requests with the responses of a recorded archive, each after the latency it had
+// when it was recorded, multiplied by `latencyScale`. A scale of zero answers right away.
+// A URL that was requested several times gets its responses in the recorded order, and the
+// last one again after that. URLs that weren't recorded are answered with an error.
+class ReplayFileSource : public FileSource {
+public:
+    class Impl;
+
+    ReplayFileSource(const ReplayArchive&, double latencyScale = 1.0);
+    ~ReplayFileSource() override;
+
+    // Answers every URL with its first recorded response again, so that the next load
+    // replays the archive from the start.
+    void rewind();
+
+    // FileSource implementation.
+    Request* request(const Resource&, uv_loop_t*, Callback) override;
+    void cancel(Request*) override;
+
+private:
+    const std::unique_ptr<util::Thread<Impl>> thread;
+};
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "util.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/still_image.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <numeric>
+
+namespace mbgl {
+namespace bench {
+
+void renderOnce(Map& map) {
+    std::promise<void> done;
+    map.renderStill([&done](std::exception_ptr error, std::unique_ptr<const StillImage>) {
+        if (error) {
+            done.set_exception(error);
+        } else {
+            done.set_value();
+        }
+    });
+    done.get_future().get();
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))];
+}
+
+void writeTimes(JSONWriter& writer, const std::vector<double>& sorted) {
+    writer.String("mean");
+    writer.Double(std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size());
+    writer.String("p50");
+    writer.Double(percentile(sorted, 0.5));
+    writer.String("p90");
+    writer.Double(percentile(sorted, 0.9));
+    writer.String("p99");
+    writer.Double(percentile(sorted, 0.99));
+    writer.String("max");
+    writer.Double(sorted.back());
+}
+
+bool parseOptions(int argc, char* argv[], const boost::program_options::options_description& desc) {
+    namespace po = boost::program_options;
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch(std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl << desc;
+        return false;
+    }
+    return true;
+}
+
+void writeOutput(const std::string& json, const std::string& file) {
+    if (file.empty()) {
+        std::cout << json << std::endl;
+    } else {
+        util::write_file(file, json);
+    }
+}
+
+}
+}
@@ -0,0 +1,47 @@
+#ifndef MBGL_BENCH_UTIL
+#define MBGL_BENCH_UTIL
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#pragma GCC diagnostic push
+#ifndef __clang__
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#pragma GCC diagnostic ignored "-Wshadow"
+#endif
+#include <boost/program_options.hpp>
+#pragma GCC diagnostic pop
+
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class Map;
+
+namespace bench {
+
+using JSONWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+// Renders one frame in still mode and waits for it. The frame loads every resource of the
+// camera position first. Throws if a resource failed to load.
+void renderOnce(Map&);
+
+// Returns the value below which the fraction `p` of the sorted values lies.
+double percentile(const std::vector<double>& sorted, double p);
+
+// Writes the mean, median, 90th and 99th percentile and maximum of sorted times as members
+// of the current JSON object.
+void writeTimes(JSONWriter&, const std::vector<double>& sorted);
+
+// Stores the command line in the variables of the options. Prints the error and the usage,
+// and returns false, if it doesn't match them.
+bool parseOptions(int argc, char* argv[], const boost::program_options::options_description&);
+
+// Writes the JSON results to the file, or to stdout if no file is given.
+void writeOutput(const std::string& json, const std::string& file);
+
+}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/still_image.hpp>
+#include <mbgl/map/metatile.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 
@@ -8,6 +9,8 @@
 #include <mbgl/platform/log.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/sqlite_cache.hpp>
+#include <mbgl/util/token.hpp>
+#include <mbgl/util/string.hpp>
 
 #pragma GCC diagnostic push
 #ifndef __clang__
@@ -21,9 +24,15 @@ namespace po = boost::program_options;
 
 #include <uv.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 int main(int argc, char *argv[]) {
     std::string style_path;
@@ -39,6 +48,12 @@ int main(int argc, char *argv[]) {
     std::vector<std::string> classes;
     std::string token;
     bool debug = false;
+    std::string tile;
+    int metatile = 1;
+    int buffer = 0;
+    int benchmark = 0;
+    int tileCache = 0;
+    unsigned threads = 0;
 
     po::options_description desc("Allowed options");
     desc.add_options()
@@ -54,12 +69,23 @@ int main(int argc, char *argv[]) {
         ("debug", po::bool_switch(&debug)->default_value(debug), "Debug mode")
         ("output,o", po::value(&output)->value_name("file")->default_value(output), "Output file name")
         ("cache,d", po::value(&cache_file)->value_name("file")->default_value(cache_file), "Cache database file name")
+        ("tile", po::value(&tile)->value_name("z/x/y"), "Render the (meta)tile whose top left tile is z/x/y")
+        ("metatile,m", po::value(&metatile)->value_name("tiles")->default_value(metatile), "Number of tiles per metatile side")
+        ("buffer", po::value(&buffer)->value_name("pixels")->default_value(buffer), "Metatile buffer that is rendered but discarded")
+        ("tile-cache", po::value(&tileCache)->value_name("tiles")->default_value(tileCache), "Number of rendered tiles to reuse between benchmark runs")
+        ("benchmark", po::value(&benchmark)->value_name("runs")->default_value(benchmark), "Render repeatedly and print render timings")
+#if MBGL_USE_OSMESA
+        ("threads", po::value(&threads)->value_name("number")->default_value(threads), "Software rasterizer threads (0 = one per core)")
+#endif
     ;
 
+    bool defaultOutput = true;
+
     try {
         po::variables_map vm;
         po::store(po::parse_command_line(argc, argv, desc), vm);
         po::notify(vm);
+        defaultOutput = vm["output"].defaulted();
     } catch(std::exception& e) {
         std::cout << "Error: " << e.what() << std::endl << desc;
         exit(1);
@@ -85,19 +111,115 @@ int main(int argc, char *argv[]) {
         fileSource.setAccessToken(std::string(token));
     }
 
-    HeadlessView view(pixelRatio, width, height);
+    std::unique_ptr<Metatile> meta;
+    if (!tile.empty()) {
+        unsigned int z = 0, x = 0, y = 0;
+        if (std::sscanf(tile.c_str(), "%u/%u/%u", &z, &x, &y) != 3 || z > 30) {
+            std::cout << "Error: invalid tile " << tile << std::endl;
+            exit(1);
+        }
+
+        if (metatile < 1 || metatile > std::numeric_limits<uint16_t>::max() ||
+            buffer < 0 || buffer > std::numeric_limits<uint16_t>::max()) {
+            std::cout << "Error: invalid metatile size or buffer" << std::endl;
+            exit(1);
+        }
+
+        try {
+            meta = std::make_unique<Metatile>(z, x, y, metatile, 256, buffer);
+        } catch (std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            exit(1);
+        }
+
+        width = meta->getWidth();
+        height = meta->getHeight();
+
+        // Metatiles are sliced into one image per tile.
+        if (defaultOutput) {
+            output = "{z}-{x}-{y}.png";
+        }
+    }
+
+#if MBGL_USE_OSMESA
+    HeadlessDisplay::setRasterizerThreads(threads);
+#else
+    (void)threads;
+#endif
+
+    HeadlessView view(pixelRatio);
+
+    if (meta) {
+        try {
+            meta->checkFramebufferSize(pixelRatio, view.getMaxFramebufferSize());
+        } catch (std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            exit(1);
+        }
+    }
+
+    view.resize(width, height);
     Map map(view, fileSource, MapMode::Still);
 
     map.setStyleJSON(style, ".");
     map.setClasses(classes);
 
-    map.setLatLngZoom({ lat, lon }, zoom);
-    map.setBearing(bearing);
+    if (meta) {
+        map.setLatLngZoom(meta->getCenter(), meta->getZoom());
+    } else {
+        map.setLatLngZoom({ lat, lon }, zoom);
+        map.setBearing(bearing);
+    }
 
     if (debug) {
         map.setDebug(debug);
     }
 
+    if (tileCache > 0) {
+        map.setTileRenderCacheSize(tileCache);
+    }
+
+    if (benchmark > 0) {
+        // The first render loads all resources; only the following renders are timed so that
+        // the numbers reflect rendering and readback, not network or cache access.
+        const auto renderOnce = [&map] {
+            std::promise<void> done;
+            map.renderStill([&done](std::exception_ptr error, std::unique_ptr<const StillImage>) {
+                if (error) {
+                    done.set_exception(error);
+                } else {
+                    done.set_value();
+                }
+            });
+            done.get_future().get();
+        };
+
+        std::vector<double> times;
+        try {
+            renderOnce();
+            for (int i = 0; i < benchmark; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                renderOnce();
+                const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                times.push_back(elapsed.count());
+            }
+        } catch(std::exception& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            exit(1);
+        }
+
+        std::sort(times.begin(), times.end());
+        const auto percentile = [&times](double p) {
+            return times[std::min(times.size() - 1, size_t(p * times.size()))];
+        };
+        std::printf("%dx%d@%gx, %d runs: mean %.2f ms, p50 %.2f ms, p95 %.2f ms, max %.2f ms\n",
+                    width, height, pixelRatio, benchmark,
+                    std::accumulate(times.begin(), times.end(), 0.0) / times.size(),
+                    percentile(0.5), percentile(0.95), times.back());
+    }
+
+    static const Metatile* metaPtr = meta.get();
+
     uv_async_t *async = new uv_async_t;
     uv_async_init(uv_default_loop(), async, [](uv_async_t *as, int) {
         std::unique_ptr<const StillImage> image(reinterpret_cast<const StillImage *>(as->data));
@@ -105,8 +227,26 @@ int main(int argc, char *argv[]) {
             delete reinterpret_cast<uv_async_t *>(handle);
         });
 
-        const std::string png = util::compress_png(image->width, image->height, image->pixels.get());
-        util::write_file(output, png);
+        if (!metaPtr) {
+            const std::string png = util::compress_png(image->width, image->height, image->pixels.get());
+            util::write_file(output, png);
+            return;
+        }
+
+        const auto tiles = metaPtr->slice(*image);
+        for (uint16_t row = 0; row < metaPtr->rows; ++row) {
+            for (uint16_t column = 0; column < metaPtr->columns; ++column) {
+                const auto& tileImage = tiles[row * metaPtr->columns + column];
+                const std::string file = util::replaceTokens(output, [&](const std::string& name) -> std::string {
+                    if (name == "z") return util::toString(int(metaPtr->z));
+                    if (name == "x") return util::toString(metaPtr->x + column);
+                    if (name == "y") return util::toString(metaPtr->y + row);
+                    return "";
+                });
+                const std::string png = util::compress_png(tileImage->width, tileImage->height, tileImage->pixels.get());
+                util::write_file(file, png);
+            }
+        }
     });
 
     map.renderStill([async](std::exception_ptr error, std::unique_ptr<const StillImage> image) {
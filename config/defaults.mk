@@ -8,6 +8,9 @@ LIBS_osx += -Dplatform_lib=$(word 1,$(PLATFORM) osx)
 LIBS_osx += -Dasset_lib=$(word 1,$(ASSET) fs)
 LIBS_osx += -Dhttp_lib=$(word 1,$(HTTP) nsurl)
 LIBS_osx += -Dcache_lib=$(word 1,$(CACHE) sqlite)
+LIBS_osx += -Dallocation_stats=$(word 1,$(ALLOCATION_STATS) 0)
+LIBS_osx += -Dtracing=$(word 1,$(TRACING) 1)
+LIBS_osx += -Dfuzzing=$(word 1,$(FUZZING) 0)
 LIBS_osx += --depth=. -Goutput_dir=.
 
 
@@ -28,6 +31,9 @@ LIBS_linux += -Dplatform_lib=$(word 1,$(PLATFORM) linux)
 LIBS_linux += -Dasset_lib=$(word 1,$(ASSET) fs)
 LIBS_linux += -Dhttp_lib=$(word 1,$(HTTP) curl)
 LIBS_linux += -Dcache_lib=$(word 1,$(CACHE) sqlite)
+LIBS_linux += -Dallocation_stats=$(word 1,$(ALLOCATION_STATS) 0)
+LIBS_linux += -Dtracing=$(word 1,$(TRACING) 1)
+LIBS_linux += -Dfuzzing=$(word 1,$(FUZZING) 0)
 LIBS_linux += --depth=. -Goutput_dir=.
 
 ANDROID_ABIS += android-lib-arm-v8
@@ -3,5 +3,6 @@
     '../linux/mapboxgl-app.gypi',
     '../test/test.gypi',
     '../bin/render.gypi',
+    '../bench/bench.gypi',
   ],
 }
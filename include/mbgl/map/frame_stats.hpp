@@ -0,0 +1,58 @@
+#ifndef MBGL_MAP_FRAME_STATS
+#define MBGL_MAP_FRAME_STATS
+
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace mbgl {
+
+// Describes the work that went into rendering a single frame.
+struct FrameStats {
+    enum Pass : uint8_t {
+        Upload,
+        TileCache,
+        Clipping,
+        Opaque,
+        Translucent,
+        Debug,
+        PassCount
+    };
+
+    static const char* passName(Pass);
+
+    // Sequence number of the frame, starting at 1 for the first frame rendered by a Map.
+    uint64_t frame = 0;
+
+    // When rendering of the frame began.
+    TimePoint start;
+
+    // CPU time spent issuing the commands of each pass.
+    std::array<Duration, PassCount> cpuTime {{}};
+
+    // GPU time spent executing each pass, measured with GL timer queries. GPU timings arrive
+    // a few frames late, and never if the driver doesn't support timer queries, so check
+    // gpuTimeAvailable before using them.
+    std::array<Duration, PassCount> gpuTime {{}};
+    bool gpuTimeAvailable = false;
+
+    uint32_t drawCalls = 0;
+    // Buffers and textures uploaded, and their size.
+    uint32_t uploads = 0;
+    uint64_t bytesUploaded = 0;
+    uint32_t tiles = 0;
+    uint32_t buckets = 0;
+
+    // Heap allocations made on the render thread during the frame. Only counted in builds
+    // configured with ALLOCATION_STATS=1; zero otherwise.
+    uint64_t allocations = 0;
+    uint64_t bytesAllocated = 0;
+
+    Duration totalCPUTime() const;
+    Duration totalGPUTime() const;
+};
+
+}
+
+#endif
@@ -4,7 +4,11 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/map/update.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/frame_stats.hpp>
+#include <mbgl/map/memory_usage.hpp>
+#include <mbgl/map/tile_lod.hpp>
 #include <mbgl/util/geo.hpp>
+#include <mbgl/util/metrics.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/vec.hpp>
 
@@ -151,7 +155,46 @@ public:
 
     // Memory
     void setSourceTileCacheSize(size_t);
-    void onLowMemory();
+    // Number of tiles whose rendered layers below the first symbol layer are kept around in
+    // still mode, so that renders that show the same tiles only redraw the labels. Each tile
+    // takes up a texture of its rendered size. Zero disables the cache, which is the default.
+    void setTileRenderCacheSize(size_t);
+
+    // Memory held by the tiles, caches and atlases of this map.
+    MemoryUsage getMemoryUsage() const;
+
+    // Frees the caches, largest first, until at least `bytes` were released. Tiles and
+    // textures are loaded or created again when they are needed. By default, all caches are
+    // freed.
+    void onLowMemory(uint64_t bytes = std::numeric_limits<uint64_t>::max());
+
+    // Parses tiles on a worker pool shared with all other Maps that enable this, instead of
+    // on a pool of their own. Takes effect when the next style is loaded.
+    void setSharedWorkers(bool);
+    bool getSharedWorkers() const;
+
+    // Directory in which the fill and line buckets of parsed vector tiles are stored, so that
+    // tiles which are loaded again skip tessellation and line extrusion. The directory must
+    // exist. An empty path, the default, disables the cache. When the files in the directory
+    // grow larger than maxSize bytes, the least recently used ones are deleted. Applies to
+    // tiles loaded afterwards.
+    void setBucketCachePath(const std::string&, uint64_t maxSize = 256 * 1024 * 1024);
+    std::string getBucketCachePath() const;
+
+    // Level of detail
+    void setTileLOD(const TileLOD&);
+    TileLOD getTileLOD() const;
+
+    // Frame statistics
+    FrameStats getLastFrameStats() const;
+    // Keeps the stats of the last `frames` rendered frames around for export. Zero, the
+    // default, disables the history.
+    void setFrameStatsHistorySize(size_t frames);
+    std::vector<FrameStats> getFrameStatsHistory() const;
+
+    // Counters and histograms of the caches, network requests, workers and GPU memory. They
+    // are process-wide, so they include the work of other Maps.
+    metrics::Snapshot getMetrics() const;
 
     // Debug
     void setDebug(bool value);
@@ -0,0 +1,60 @@
+#ifndef MBGL_MAP_MEMORY_USAGE
+#define MBGL_MAP_MEMORY_USAGE
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mbgl {
+
+// Bytes held in main memory and in GL buffers and textures.
+struct MemoryFootprint {
+    uint64_t cpu = 0;
+    uint64_t gpu = 0;
+
+    uint64_t total() const { return cpu + gpu; }
+
+    MemoryFootprint& operator+=(const MemoryFootprint& rhs) {
+        cpu += rhs.cpu;
+        gpu += rhs.gpu;
+        return *this;
+    }
+};
+
+// Breaks the memory held by a Map down into the parts that hold it. Sizes of containers are
+// estimated from their element counts, so they are approximate.
+struct MemoryUsage {
+    enum Category : uint8_t {
+        Tiles,           // Tiles that are shown or loading, including their buckets.
+        TileCache,       // Tiles that are kept around to be shown again.
+        TileRenderCache, // Rendered tiles that are kept around in still mode.
+        TexturePool,     // Textures of raster tiles that are kept around for reuse.
+        GlyphAtlas,
+        SpriteAtlas,
+        LineAtlas,
+        FontStacks,      // Glyph bitmaps and metrics of all loaded glyph ranges.
+        CategoryCount
+    };
+
+    static const char* categoryName(Category);
+
+    // Whether the map can free the memory of the category and reload or recreate its
+    // contents when they are needed again.
+    static bool isReclaimable(Category);
+
+    std::array<MemoryFootprint, CategoryCount> categories {};
+
+    uint32_t tiles = 0;
+    uint32_t cachedTiles = 0;
+
+    MemoryFootprint total() const;
+
+    // The reclaimable categories to free to release at least `bytes`, largest first. All
+    // nonempty reclaimable categories if they hold less than that.
+    std::vector<Category> reclaimOrder(uint64_t bytes = std::numeric_limits<uint64_t>::max()) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef MBGL_MAP_METATILE
+#define MBGL_MAP_METATILE
+
+#include <mbgl/util/geo.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class StillImage;
+
+// A metatile is a block of adjacent tiles that gets rendered into a single framebuffer and is
+// then cut into individual tile images. Rendering the block at once means that symbol placement
+// and the underlying vector tiles are shared across all of its tiles, and labels stay consistent
+// across tile edges.
+class Metatile {
+public:
+    // Creates a metatile of size × size tiles whose top left tile is z/x/y. The block is clipped
+    // to the edges of the world. An optional buffer (in logical pixels) is rendered around the
+    // block and discarded when slicing. Throws std::invalid_argument if the view would be larger
+    // than maxDimension. Whether the framebuffer fits is checked by checkFramebufferSize().
+    Metatile(uint8_t z, uint32_t x, uint32_t y, uint16_t size,
+             uint16_t tileSize = 256, uint16_t buffer = 0);
+
+    // Logical dimensions of the view that is required to render this metatile.
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+
+    // Largest logical view dimension. Views are sized in 16 bit values.
+    static const uint32_t maxDimension = 65535;
+
+    // Physical dimensions of the framebuffer that renders this metatile at the pixel ratio.
+    uint32_t getFramebufferWidth(float pixelRatio) const;
+    uint32_t getFramebufferHeight(float pixelRatio) const;
+
+    // Throws std::invalid_argument if the framebuffer for the pixel ratio is larger than
+    // maxFramebufferSize in either dimension. The limit depends on the OpenGL implementation,
+    // e.g. HeadlessView::getMaxFramebufferSize().
+    void checkFramebufferSize(float pixelRatio, uint32_t maxFramebufferSize) const;
+
+    // Camera position that renders this metatile when used with a view of the above dimensions.
+    LatLng getCenter() const;
+    double getZoom() const;
+
+    // Cuts an image rendered for this metatile into its tiles. Images are ordered row by row,
+    // starting with the top left tile. The pixel ratio is derived from the image dimensions.
+    std::vector<std::unique_ptr<StillImage>> slice(const StillImage&) const;
+
+    const uint8_t z;
+    const uint32_t x;
+    const uint32_t y;
+    const uint16_t columns;
+    const uint16_t rows;
+    const uint16_t tileSize;
+    const uint16_t buffer;
+};
+
+}
+
+#endif
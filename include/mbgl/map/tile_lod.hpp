@@ -0,0 +1,32 @@
+#ifndef MBGL_MAP_TILE_LOD
+#define MBGL_MAP_TILE_LOD
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+// Controls how sources trade detail for tile count on viewports that need many tiles, e.g.
+// very large displays. The default loads every tile at the ideal zoom level.
+struct TileLOD {
+    // Radius around the center of the viewport, in pixels, in which tiles are loaded at the
+    // ideal zoom level. Beyond it, every doubling of the distance loads tiles one zoom level
+    // lower. Zero means the whole viewport, unless a tile budget is set.
+    float focusRadius = 0;
+
+    // The maximum number of zoom levels a tile is lowered by.
+    uint8_t maxLevelDrop = 3;
+
+    // The maximum number of tiles a source loads for one viewport. The focus radius is halved
+    // until the cover fits, or until all tiles outside of it are lowered by maxLevelDrop
+    // levels. Zero means unlimited.
+    std::size_t tileBudget = 0;
+
+    inline bool isEnabled() const {
+        return focusRadius > 0 || tileBudget > 0;
+    }
+};
+
+}
+
+#endif
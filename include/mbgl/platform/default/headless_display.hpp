@@ -18,6 +18,13 @@ public:
     Display *xDisplay = nullptr;
     GLXFBConfig *fbConfigs = nullptr;
 #endif
+
+#if MBGL_USE_OSMESA
+    // Sets the number of threads that Mesa's llvmpipe software rasterizer uses. The driver reads
+    // this setting when the first context is created, so this must be called before creating any
+    // HeadlessView. Zero uses the driver default of one thread per CPU core.
+    static void setRasterizerThreads(unsigned threads);
+#endif
 };
 
 }
@@ -3,6 +3,9 @@
 
 #ifdef __APPLE__
 #define MBGL_USE_CGL 1
+#elif MBGL_USE_OSMESA
+#define GL_GLEXT_PROTOTYPES
+typedef struct osmesa_context *OSMesaContext;
 #else
 #define GL_GLEXT_PROTOTYPES
 #define MBGL_USE_GLX 1
@@ -42,6 +45,9 @@ public:
 
     void resize(uint16_t width, uint16_t height);
 
+    // Largest framebuffer dimension, in physical pixels, that the OpenGL context supports.
+    uint32_t getMaxFramebufferSize();
+
 private:
     void createContext();
     void loadExtensions();
@@ -64,6 +70,13 @@ private:
     GLXPbuffer glxPbuffer = 0;
 #endif
 
+#if MBGL_USE_OSMESA
+    OSMesaContext glContext = nullptr;
+    // OSMesa needs a color buffer to make the context current. We render to framebuffers
+    // anyway, so this is just a small dummy buffer.
+    std::unique_ptr<uint32_t[]> osmesaBuffer;
+#endif
+
     bool extensionsLoaded = false;
 
     GLuint fbo = 0;
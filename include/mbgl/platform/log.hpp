@@ -5,6 +5,8 @@
 
 #include <mbgl/util/noncopyable.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -17,13 +19,41 @@ public:
         virtual ~Observer() = default;
 
         // When an observer is set, this function will be called for every log
-        // message. Returning true will consume the message.
+        // message, on the thread that records it. Returning true will consume the message.
         virtual bool onRecord(EventSeverity severity, Event event, int64_t code, const std::string &msg) = 0;
     };
 
     static void setObserver(std::unique_ptr<Observer> Observer);
     static std::unique_ptr<Observer> removeObserver();
 
+    // Filters messages at runtime, in addition to the severities and events that are disabled
+    // at compile time in event.hpp. Filtered messages aren't formatted.
+    static void setMinimumSeverity(EventSeverity);
+    static void setEventEnabled(Event, bool enabled);
+
+    // Records at most `count` warnings and errors per second that have the same event and
+    // format string. Messages that the caller formatted count as the same if they only differ
+    // in their digits, such as tile IDs. The number of suppressed messages is reported when
+    // recording resumes, or on flush(). Zero disables the limit.
+    static const uint32_t defaultRateLimit = 10;
+    static void setRateLimit(uint32_t count);
+
+    // Messages that aren't consumed by the observer are written by a background thread, so
+    // that slow platform logging doesn't hold up the recording thread. Errors are written
+    // synchronously. Reports the suppressed messages, and blocks until all messages recorded
+    // so far were written.
+    static void flush();
+
+    // Replaces the platform log as the destination of messages that aren't consumed by the
+    // observer. Passing nullptr restores the platform log.
+    using Writer = void (*)(EventSeverity, const std::string&);
+    static void setWriter(Writer);
+
+    static bool isEnabled(EventSeverity severity, Event event) {
+        return uint8_t(severity) >= minimumSeverity.load(std::memory_order_relaxed) &&
+               !(disabledEventMask.load(std::memory_order_relaxed) & (1u << uint8_t(event)));
+    }
+
 private:
     template <typename T, size_t N>
     constexpr static bool includes(const T e, const T (&l)[N], const size_t i = 0) {
@@ -55,7 +85,8 @@ public:
     static inline void Record(EventSeverity severity, Event event, Args&& ...args) {
         if (!includes(severity, disabledEventSeverities) &&
             !includes(event, disabledEvents) &&
-            !includes({ severity, event }, disabledEventPermutations)) {
+            !includes({ severity, event }, disabledEventPermutations) &&
+            isEnabled(severity, event)) {
                 record(severity, event, ::std::forward<Args>(args)...);
         }
     }
@@ -66,6 +97,15 @@ private:
     static void record(EventSeverity severity, Event event, int64_t code);
     static void record(EventSeverity severity, Event event, int64_t code, const std::string &msg);
 
+    // Passes a message that passed the filters and the rate limit on to the observer and sink.
+    static void deliver(EventSeverity severity, Event event, int64_t code, const std::string &msg);
+
+    // Writes a formatted message to the writer, or the platform log.
+    static void write(EventSeverity severity, const std::string &msg);
+
+    static std::atomic<uint8_t> minimumSeverity;
+    static std::atomic<uint32_t> disabledEventMask;
+
     // This method is the data sink that must be implemented by each platform we
     // support. It should ideally output the error message in a human readable
     // format to the developer.
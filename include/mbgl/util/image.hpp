@@ -1,6 +1,7 @@
 #ifndef MBGL_UTIL_IMAGE
 #define MBGL_UTIL_IMAGE
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -14,6 +15,15 @@ class Image {
 public:
     explicit Image(const std::string &img);
 
+    // Images whose pixels take more bytes than this aren't decoded. The formats allow images
+    // that would take gigabytes of memory; this fits into the memory budget of the fuzz targets.
+    static const uint64_t maxSize = 64 * 1024 * 1024;
+
+    // Whether an image of this size is decoded.
+    static inline bool isDecodable(uint64_t width, uint64_t height) {
+        return width * height <= maxSize / 4;
+    }
+
     inline const char *getData() const { return img.get(); }
     inline uint32_t getWidth() const { return width; }
     inline uint32_t getHeight() const { return height; }
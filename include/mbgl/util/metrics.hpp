@@ -0,0 +1,42 @@
+#ifndef MBGL_UTIL_METRICS
+#define MBGL_UTIL_METRICS
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace metrics {
+
+struct HistogramSnapshot {
+    // Exclusive upper bounds of all buckets but the last one, which has no upper bound.
+    std::vector<uint64_t> bounds;
+    // Number of values recorded per bucket; has one more entry than `bounds`.
+    std::vector<uint64_t> counts;
+
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    double mean() const;
+};
+
+// The values of all metrics of the process, keyed by name, e.g. "tile_cache.hits". Metrics are
+// process-wide, so they add up the work of all Maps. Names end in the unit of the metric where
+// it isn't a plain count, e.g. "http.latency_ms".
+struct Snapshot {
+    // Values that only ever increase.
+    std::map<std::string, uint64_t> counters;
+    // Current levels, e.g. queue depths and memory in use.
+    std::map<std::string, int64_t> gauges;
+    std::map<std::string, HistogramSnapshot> histograms;
+};
+
+// Reads all metrics. Values are read one by one without stopping the threads that update them,
+// so related metrics may be off by the updates that happened in between.
+Snapshot snapshot();
+
+}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef MBGL_UTIL_TRACE
+#define MBGL_UTIL_TRACE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace trace {
+
+// Records timed events of all threads into per-thread ring buffers, so that the cross-thread
+// path of a slow frame can be inspected after the fact. Events are exported in the Chrome
+// trace-event format, which chrome://tracing and other trace viewers open.
+//
+// Recording is off until start() is called; until then, an instrumented scope costs a relaxed
+// atomic load. Builds configured with TRACING=0 define MBGL_DISABLE_TRACING, which removes the
+// MBGL_TRACE_* macros entirely.
+
+// Starts recording, and discards the events recorded so far. Each thread keeps its most recent
+// `eventsPerThread` events. When a thread exits, its events are kept until a new thread takes
+// over its buffer.
+void start(std::size_t eventsPerThread = 32768);
+
+// Stops recording, and frees the per-thread buffers. The recorded events stay available for
+// export until the next start().
+void stop();
+
+// Returns the recorded events of all threads as a Chrome trace-event JSON document.
+std::string exportChromeTrace();
+
+enum class Phase : char {
+    Complete = 'X',
+    Instant = 'i',
+    AsyncBegin = 'b',
+    AsyncEnd = 'e',
+};
+
+// Category and name have to be string literals, or otherwise outlive the export.
+struct Event {
+    const char* category;
+    const char* name;
+    Phase phase;
+    uint64_t timestamp; // nanoseconds on the steady clock
+    uint64_t duration;  // nanoseconds, for complete events
+    uint64_t id;        // matches the begin and end of async events
+};
+
+namespace detail {
+
+extern std::atomic<bool> recording;
+
+uint64_t now();
+void record(const Event&);
+
+}
+
+inline bool isRecording() {
+    return detail::recording.load(std::memory_order_relaxed);
+}
+
+// Records the time from construction to destruction as a complete event.
+class Scope {
+public:
+    Scope(const char* category_, const char* name_)
+        : category(category_), name(name_), start(isRecording() ? detail::now() : 0) {}
+
+    ~Scope() {
+        if (start && isRecording()) {
+            detail::record({ category, name, Phase::Complete, start, detail::now() - start, 0 });
+        }
+    }
+
+private:
+    const char* const category;
+    const char* const name;
+    const uint64_t start;
+};
+
+inline void instant(const char* category, const char* name) {
+    if (isRecording()) {
+        detail::record({ category, name, Phase::Instant, detail::now(), 0, 0 });
+    }
+}
+
+// Async events mark operations that begin and end on different threads, or overlap with
+// other operations of the same thread, such as network requests.
+inline void asyncBegin(const char* category, const char* name, const void* id) {
+    if (isRecording()) {
+        detail::record({ category, name, Phase::AsyncBegin, detail::now(), 0, reinterpret_cast<uintptr_t>(id) });
+    }
+}
+
+inline void asyncEnd(const char* category, const char* name, const void* id) {
+    if (isRecording()) {
+        detail::record({ category, name, Phase::AsyncEnd, detail::now(), 0, reinterpret_cast<uintptr_t>(id) });
+    }
+}
+
+}
+}
+
+#ifndef MBGL_DISABLE_TRACING
+#define MBGL_TRACE_CONCAT_(a, b) a##b
+#define MBGL_TRACE_CONCAT(a, b) MBGL_TRACE_CONCAT_(a, b)
+#define MBGL_TRACE_SCOPE(category, name) \
+    const ::mbgl::trace::Scope MBGL_TRACE_CONCAT(mbglTraceScope, __LINE__)(category, name)
+#define MBGL_TRACE_INSTANT(category, name) ::mbgl::trace::instant(category, name)
+#define MBGL_TRACE_ASYNC_BEGIN(category, name, id) ::mbgl::trace::asyncBegin(category, name, id)
+#define MBGL_TRACE_ASYNC_END(category, name, id) ::mbgl::trace::asyncEnd(category, name, id)
+#else
+#define MBGL_TRACE_SCOPE(category, name) ((void)0)
+#define MBGL_TRACE_INSTANT(category, name) ((void)0)
+#define MBGL_TRACE_ASYNC_BEGIN(category, name, id) ((void)0)
+#define MBGL_TRACE_ASYNC_END(category, name, id) ((void)0)
+#endif
+
+#endif
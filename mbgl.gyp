@@ -8,10 +8,12 @@
     './gyp/standalone.gypi',
     './gyp/core.gypi',
     './gyp/none.gypi',
+    './gyp/replay.gypi',
   ],
   'conditions': [
     ['headless_lib == "cgl" and host == "osx"', { 'includes': [ './gyp/headless-cgl.gypi' ] } ],
     ['headless_lib == "glx" and host == "linux"', { 'includes': [ './gyp/headless-glx.gypi' ] } ],
+    ['headless_lib == "osmesa" and host == "linux"', { 'includes': [ './gyp/headless-osmesa.gypi' ] } ],
     ['platform_lib == "osx" and host == "osx"', { 'includes': [ './gyp/platform-osx.gypi' ] } ],
     ['platform_lib == "ios" and host == "ios"', { 'includes': [ './gyp/platform-ios.gypi' ] } ],
     ['platform_lib == "linux"', { 'includes': [ './gyp/platform-linux.gypi' ] } ],
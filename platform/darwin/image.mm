@@ -93,11 +93,19 @@ Image::Image(const std::string &source_data) {
         return;
     }
 
+    if (!isDecodable(CGImageGetWidth(image), CGImageGetHeight(image))) {
+        CGColorSpaceRelease(color_space);
+        CGImageRelease(image);
+        CFRelease(image_source);
+        CFRelease(data);
+        return;
+    }
+
     width = uint32_t(CGImageGetWidth(image));
     height = uint32_t(CGImageGetHeight(image));
     CGRect rect = {{ 0, 0 }, { static_cast<CGFloat>(width), static_cast<CGFloat>(height) }};
 
-    img = std::make_unique<char[]>(width * height * 4);
+    img = std::make_unique<char[]>(std::size_t(width) * height * 4);
     CGContextRef context = CGBitmapContextCreate(img.get(), width, height, 8, width * 4,
         color_space, kCGImageAlphaPremultipliedLast);
     if (!context) {
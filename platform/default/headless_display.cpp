@@ -7,6 +7,11 @@
 #include <GL/glx.h>
 #endif
 
+#if MBGL_USE_OSMESA
+#include <cstdlib>
+#include <string>
+#endif
+
 namespace mbgl {
 
 HeadlessDisplay::HeadlessDisplay() {
@@ -68,6 +73,12 @@ HeadlessDisplay::HeadlessDisplay() {
         throw std::runtime_error("No Framebuffer configurations.");
     }
 #endif
+
+#if MBGL_USE_OSMESA
+    // Prefer the multithreaded llvmpipe rasterizer over softpipe unless the environment
+    // explicitly asks for another Gallium driver.
+    setenv("GALLIUM_DRIVER", "llvmpipe", 0);
+#endif
 }
 
 HeadlessDisplay::~HeadlessDisplay() {
@@ -81,4 +92,14 @@ HeadlessDisplay::~HeadlessDisplay() {
 #endif
 }
 
+#if MBGL_USE_OSMESA
+void HeadlessDisplay::setRasterizerThreads(unsigned threads) {
+    if (threads) {
+        setenv("LP_NUM_THREADS", std::to_string(threads).c_str(), 1);
+    } else {
+        unsetenv("LP_NUM_THREADS");
+    }
+}
+#endif
+
 }
@@ -6,6 +6,7 @@
 #include <mbgl/map/still_image.hpp>
 
 
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 #include <string>
@@ -16,6 +17,8 @@
 #include <CoreFoundation/CoreFoundation.h>
 #elif MBGL_USE_GLX
 #include <GL/glx.h>
+#elif MBGL_USE_OSMESA
+#include <GL/osmesa.h>
 #endif
 
 namespace mbgl {
@@ -59,6 +62,12 @@ void HeadlessView::loadExtensions() {
     });
 #endif
 
+#if MBGL_USE_OSMESA
+    gl::InitializeExtensions([](const char * name) {
+        return reinterpret_cast<gl::glProc>(OSMesaGetProcAddress(name));
+    });
+#endif
+
     extensionsLoaded = true;
 }
 
@@ -108,6 +117,15 @@ void HeadlessView::createContext() {
     };
     glxPbuffer = glXCreatePbuffer(xDisplay, fbConfigs[0], pbufferAttributes);
 #endif
+
+#if MBGL_USE_OSMESA
+    glContext = OSMesaCreateContextExt(OSMESA_RGBA, 24, 8, 0, nullptr);
+    if (glContext == nullptr) {
+        throw std::runtime_error("Error creating GL context object.");
+    }
+
+    osmesaBuffer = std::make_unique<uint32_t[]>(8 * 8);
+#endif
 }
 
 bool HeadlessView::isActive() {
@@ -161,6 +179,20 @@ void HeadlessView::resize(const uint16_t width, const uint16_t height) {
     deactivate();
 }
 
+uint32_t HeadlessView::getMaxFramebufferSize() {
+    activate();
+
+    // The view renders into renderbuffers; the tile render cache renders into textures.
+    GLint maxRenderbufferSize = 0;
+    GLint maxTextureSize = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE_EXT, &maxRenderbufferSize));
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+
+    deactivate();
+
+    return std::min(maxRenderbufferSize, maxTextureSize);
+}
+
 std::unique_ptr<StillImage> HeadlessView::readStillImage() {
     assert(isActive());
 
@@ -224,6 +256,10 @@ HeadlessView::~HeadlessView() {
 
     glXDestroyContext(xDisplay, glContext);
 #endif
+
+#if MBGL_USE_OSMESA
+    OSMesaDestroyContext(glContext);
+#endif
 }
 
 void HeadlessView::notify() {
@@ -266,6 +302,12 @@ void HeadlessView::activate() {
     }
 #endif
 
+#if MBGL_USE_OSMESA
+    if (!OSMesaMakeCurrent(glContext, osmesaBuffer.get(), GL_UNSIGNED_BYTE, 8, 8)) {
+        throw std::runtime_error("Switching OpenGL context failed.\n");
+    }
+#endif
+
     loadExtensions();
 }
 
@@ -287,6 +329,12 @@ void HeadlessView::deactivate() {
         throw std::runtime_error("Removing OpenGL context failed.\n");
     }
 #endif
+
+#if MBGL_USE_OSMESA
+    if (!OSMesaMakeCurrent(nullptr, nullptr, 0, 0, 0)) {
+        throw std::runtime_error("Removing OpenGL context failed.\n");
+    }
+#endif
 }
 
 void HeadlessView::invalidate() {
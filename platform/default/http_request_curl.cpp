@@ -2,6 +2,7 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/platform/log.hpp>
 
 #include <mbgl/util/time.hpp>
@@ -34,6 +35,15 @@ void handleError(CURLcode code) {
 
 namespace mbgl {
 
+namespace {
+
+metrics::Counter httpRequests("http.requests");
+metrics::Counter httpErrors("http.errors");
+metrics::Counter httpBytesReceived("http.bytes_received");
+metrics::Histogram httpLatency("http.latency_ms", 8);
+
+}
+
 enum class ResponseStatus : int8_t {
     // This error probably won't be resolved by retrying anytime soon. We are giving up.
     PermanentError,
@@ -143,6 +153,9 @@ private:
     enum : bool { PreemptImmediately, ExponentialBackoff } strategy = PreemptImmediately;
     int attempts = 0;
 
+    // When the current attempt started.
+    TimePoint started;
+
     static const int maxAttempts = 4;
 
     char error[CURL_ERROR_SIZE];
@@ -524,6 +537,8 @@ void HTTPRequest::cancel() {
 void HTTPRequest::start() {
     // Count up the attempts.
     attempts++;
+    started = Clock::now();
+    httpRequests.add();
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
@@ -541,6 +556,7 @@ size_t HTTPRequest::writeCallback(void *const contents, const size_t size, const
     }
 
     impl->response->data.append((char *)contents, size * nmemb);
+    httpBytesReceived.add(size * nmemb);
     return size * nmemb;
 }
 
@@ -672,6 +688,8 @@ void HTTPRequest::handleResult(CURLcode code) {
         return;
     }
 
+    httpLatency.record(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count());
+
     // Make sure a response object exists in case we haven't got any headers
     // or content.
     if (!response) {
@@ -680,6 +698,7 @@ void HTTPRequest::handleResult(CURLcode code) {
 
     // Add human-readable error code
     if (code != CURLE_OK) {
+        httpErrors.add();
         response->status = Response::Error;
         response->message = std::string { curl_easy_strerror(code) } + ": " + error;
 
@@ -721,11 +740,13 @@ void HTTPRequest::handleResult(CURLcode code) {
             // Server errors may be temporary, so back off exponentially.
             response->status = Response::Error;
             response->message = "HTTP status code " + std::to_string(responseCode);
+            httpErrors.add();
             return finish(ResponseStatus::TemporaryError);
         } else {
             // We don't know how to handle any other errors, so declare them as permanently failing.
             response->status = Response::Error;
             response->message = "HTTP status code " + std::to_string(responseCode);
+            httpErrors.add();
             return finish(ResponseStatus::PermanentError);
         }
     }
@@ -81,7 +81,10 @@ Image::Image(std::string const& data)
         auto reader = getImageReader(data.c_str(), data.size());
         width = reader->width();
         height = reader->height();
-        img = std::make_unique<char[]>(width * height * 4);
+        if (!isDecodable(width, height)) {
+            throw ImageReaderException("image is too large: " + std::to_string(width) + "x" + std::to_string(height));
+        }
+        img = std::make_unique<char[]>(std::size_t(width) * height * 4);
         reader->read(0, 0, width, height, img.get());
     }
     catch (ImageReaderException const& ex)
@@ -4,7 +4,9 @@
 
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/trace.hpp>
 #include <mbgl/platform/log.hpp>
 
 #include "sqlite3.hpp"
@@ -12,6 +14,15 @@
 
 namespace mbgl {
 
+namespace {
+
+metrics::Counter cacheHits("sqlite_cache.hits");
+metrics::Counter cacheMisses("sqlite_cache.misses");
+metrics::Counter cacheStores("sqlite_cache.stores");
+metrics::Counter cacheBytesStored("sqlite_cache.bytes_stored");
+
+}
+
 std::string removeAccessTokenFromURL(const std::string &url) {
     const size_t token_start = url.find("access_token=");
     // Ensure that token exists, isn't at the front and is preceded by either & or ?.
@@ -135,6 +146,7 @@ std::unique_ptr<WorkRequest> SQLiteCache::get(const Resource &resource, Callback
 }
 
 void SQLiteCache::Impl::get(const Resource &resource, Callback callback) {
+    MBGL_TRACE_SCOPE("cache", "get");
     try {
         // This is called in the SQLite event loop.
         if (!db) {
@@ -167,9 +179,11 @@ void SQLiteCache::Impl::get(const Resource &resource, Callback callback) {
             if (getStmt->get<int>(5)) { // == compressed
                 response->data = util::decompress(response->data);
             }
+            cacheHits.add();
             callback(std::move(response));
         } else {
             // There is no data.
+            cacheMisses.add();
             callback(nullptr);
         }
     } catch (mapbox::sqlite::Exception& ex) {
@@ -190,6 +204,7 @@ void SQLiteCache::put(const Resource &resource, std::shared_ptr<const Response>
 }
 
 void SQLiteCache::Impl::put(const Resource& resource, std::shared_ptr<const Response> response) {
+    MBGL_TRACE_SCOPE("cache", "put");
     try {
         if (!db) {
             createDatabase();
@@ -222,7 +237,8 @@ void SQLiteCache::Impl::put(const Resource& resource, std::shared_ptr<const Resp
             data = util::compress(response->data);
         }
 
-        if (!data.empty() && data.size() < response->data.size()) {
+        const bool compressed = !data.empty() && data.size() < response->data.size();
+        if (compressed) {
             // Store the compressed data when it is smaller than the original
             // uncompressed data.
             putStmt->bind(7 /* data */, data, false); // do not retain the string internally.
@@ -233,6 +249,8 @@ void SQLiteCache::Impl::put(const Resource& resource, std::shared_ptr<const Resp
         }
 
         putStmt->run();
+        cacheStores.add();
+        cacheBytesStored.add(compressed ? data.size() : response->data.size());
     } catch (mapbox::sqlite::Exception& ex) {
         Log::Error(Event::Database, ex.code, ex.what());
     }
@@ -4,6 +4,7 @@
 #include <mbgl/platform/log.hpp>
 
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/json.hpp>
 
 #include <rapidjson/document.h>
 
@@ -111,6 +112,11 @@ Sprites parseSprite(const std::string& image, const std::string& json) {
         return sprites;
     }
 
+    if (util::jsonDepth(json) > util::maxJSONDepth) {
+        Log::Warning(Event::Sprite, "Sprite JSON is nested too deeply");
+        return sprites;
+    }
+
     Document doc;
     doc.Parse<0>(json.c_str());
 
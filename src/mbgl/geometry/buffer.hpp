@@ -1,13 +1,18 @@
 #ifndef MBGL_GEOMETRY_BUFFER
 #define MBGL_GEOMETRY_BUFFER
 
+#include <mbgl/gl/stats.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/thread_context.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <cstdlib>
+#include <cstring>
 #include <cassert>
 #include <stdexcept>
 
@@ -25,6 +30,7 @@ public:
         cleanup();
         if (buffer != 0) {
             util::ThreadContext::getGLObjectStore()->abandonBuffer(buffer);
+            metrics::gpuBufferBytes.subtract(pos);
             buffer = 0;
         }
     }
@@ -44,6 +50,7 @@ public:
         if (buffer) {
             MBGL_CHECK_ERROR(glBindBuffer(bufferType, buffer));
         } else {
+            MBGL_TRACE_SCOPE("gl", "buffer upload");
             MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
             MBGL_CHECK_ERROR(glBindBuffer(bufferType, buffer));
             if (array == nullptr) {
@@ -51,6 +58,8 @@ public:
                 pos = 0;
             }
             MBGL_CHECK_ERROR(glBufferData(bufferType, pos, array, GL_STATIC_DRAW));
+            gl::stats::upload(pos);
+            metrics::gpuBufferBytes.add(pos);
             if (!retainAfterUpload) {
                 cleanup();
             }
@@ -68,6 +77,44 @@ public:
         return buffer;
     }
 
+    // Raw contents of the CPU buffer. Only available until the buffer is uploaded.
+    inline const void* data() const {
+        return array;
+    }
+    inline size_t bytes() const {
+        return pos;
+    }
+
+    // Memory held by the buffer, including unused capacity of the CPU buffer.
+    inline MemoryFootprint getMemoryFootprint() const {
+        return { array ? length : 0, buffer ? pos : 0 };
+    }
+
+    // Memory held by `items` items of the buffer, for buckets that share a buffer.
+    inline MemoryFootprint getMemoryFootprint(size_t items) const {
+        return { array ? items * itemSize : 0, buffer ? items * itemSize : 0 };
+    }
+
+    // Appends raw items, e.g. ones that were previously read with data().
+    void append(const void* items, size_t byteCount) {
+        assert(byteCount % itemSize == 0);
+        if (byteCount == 0) {
+            return;
+        }
+        if (buffer != 0) {
+            throw std::runtime_error("Can't add elements after buffer was bound to GPU");
+        }
+        if (length < pos + byteCount) {
+            while (length < pos + byteCount) length += defaultLength;
+            array = realloc(array, length);
+            if (array == nullptr) {
+                throw std::runtime_error("Buffer reallocation failed");
+            }
+        }
+        std::memcpy(reinterpret_cast<char *>(array) + pos, items, byteCount);
+        pos += byteCount;
+    }
+
     // Uploads the buffer to the GPU to be available when we need it.
     inline void upload() {
         if (!buffer) {
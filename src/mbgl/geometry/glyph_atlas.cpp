@@ -1,10 +1,13 @@
 #include <mbgl/geometry/glyph_atlas.hpp>
 
 #include <mbgl/text/font_stack.hpp>
+#include <mbgl/gl/stats.hpp>
 
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/platform/platform.hpp>
+#include <mbgl/util/metrics_registry.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <cassert>
 #include <algorithm>
@@ -12,12 +15,25 @@
 
 using namespace mbgl;
 
+namespace {
+
+metrics::Gauge capacityPixels("glyph_atlas.capacity_pixels");
+metrics::Gauge usedPixels("glyph_atlas.used_pixels");
+
+}
+
 GlyphAtlas::GlyphAtlas(uint16_t width_, uint16_t height_)
     : width(width_),
       height(height_),
       bin(width_, height_),
       data(std::make_unique<uint8_t[]>(width_ * height_)),
       dirty(true) {
+    capacityPixels.add(width * height);
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    capacityPixels.subtract(width * height);
+    usedPixels.subtract(used);
 }
 
 void GlyphAtlas::addGlyphs(uintptr_t tileUID,
@@ -28,18 +44,15 @@ void GlyphAtlas::addGlyphs(uintptr_t tileUID,
 {
     std::lock_guard<std::mutex> lock(mtx);
 
-    const std::map<uint32_t, SDFGlyph>& sdfs = fontStack.getSDFs();
-
     for (uint32_t chr : text)
     {
-        auto sdf_it = sdfs.find(chr);
-        if (sdf_it == sdfs.end()) {
+        const SDFGlyph* sdf = fontStack.getGlyph(chr);
+        if (!sdf) {
             continue;
         }
 
-        const SDFGlyph& sdf = sdf_it->second;
-        Rect<uint16_t> rect = addGlyph(tileUID, stackName, sdf);
-        face.emplace(chr, Glyph{rect, sdf.metrics});
+        Rect<uint16_t> rect = addGlyph(tileUID, stackName, *sdf);
+        face.emplace(chr, Glyph{rect, sdf->metrics});
     }
 }
 
@@ -85,6 +98,9 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
         return rect;
     }
 
+    used += rect.w * rect.h;
+    usedPixels.add(rect.w * rect.h);
+
     assert(rect.x + rect.w <= width);
     assert(rect.y + rect.h <= height);
 
@@ -127,6 +143,8 @@ void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
                 }
 
                 bin.release(rect);
+                used -= rect.w * rect.h;
+                usedPixels.subtract(rect.w * rect.h);
 
                 // Make sure to post-increment the iterator: This will return the
                 // current iterator, but will go to the next position before we
@@ -142,11 +160,13 @@ void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
 
 void GlyphAtlas::upload() {
     if (dirty) {
+        MBGL_TRACE_SCOPE("gl", "glyph atlas upload");
         const bool first = !texture;
         bind();
 
         std::lock_guard<std::mutex> lock(mtx);
 
+        gl::stats::upload(width * height);
         if (first) {
             MBGL_CHECK_ERROR(glTexImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -181,6 +201,11 @@ void GlyphAtlas::upload() {
     }
 }
 
+MemoryFootprint GlyphAtlas::getMemoryFootprint() const {
+    const uint64_t bytes = uint64_t(width) * height;
+    return { bytes, texture ? bytes : 0 };
+}
+
 void GlyphAtlas::bind() {
     if (!texture) {
         MBGL_CHECK_ERROR(glGenTextures(1, &texture));
@@ -2,6 +2,7 @@
 #define MBGL_GEOMETRY_GLYPH_ATLAS
 
 #include <mbgl/geometry/binpack.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
@@ -16,6 +17,7 @@ namespace mbgl {
 class GlyphAtlas : public util::noncopyable {
 public:
     GlyphAtlas(uint16_t width, uint16_t height);
+    ~GlyphAtlas();
 
     void addGlyphs(uintptr_t tileUID,
                    const std::u32string& text,
@@ -31,6 +33,9 @@ public:
     // the texture is only bound when the data is out of date (=dirty).
     void upload();
 
+    // Memory held by the pixels and by the texture. Must be called on the render thread.
+    MemoryFootprint getMemoryFootprint() const;
+
     const uint16_t width = 0;
     const uint16_t height = 0;
 
@@ -48,6 +53,8 @@ private:
 
     std::mutex mtx;
     BinPack<uint16_t> bin;
+    // Area of the glyphs in the bin, in pixels.
+    int64_t used = 0;
     std::map<std::string, std::map<uint32_t, GlyphValue>> index;
     const std::unique_ptr<uint8_t[]> data;
     std::atomic<bool> dirty;
@@ -1,9 +1,11 @@
 #include <mbgl/geometry/line_atlas.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/platform/platform.hpp>
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/thread_context.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <boost/functional/hash.hpp>
 
@@ -130,6 +132,11 @@ LinePatternPos LineAtlas::addDash(const std::vector<float> &dasharray, bool roun
     return position;
 };
 
+MemoryFootprint LineAtlas::getMemoryFootprint() const {
+    const uint64_t bytes = uint64_t(width) * height;
+    return { bytes, texture ? bytes : 0 };
+}
+
 void LineAtlas::upload() {
     if (dirty) {
         bind();
@@ -153,6 +160,8 @@ void LineAtlas::bind() {
     }
 
     if (dirty) {
+        MBGL_TRACE_SCOPE("gl", "line atlas upload");
+        gl::stats::upload(width * height);
         if (first) {
             MBGL_CHECK_ERROR(glTexImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -1,6 +1,8 @@
 #ifndef MBGL_GEOMETRY_LINE_ATLAS
 #define MBGL_GEOMETRY_LINE_ATLAS
 
+#include <mbgl/map/memory_usage.hpp>
+
 #include <vector>
 #include <map>
 #include <memory>
@@ -30,6 +32,9 @@ public:
     LinePatternPos getDashPosition(const std::vector<float>&, bool);
     LinePatternPos addDash(const std::vector<float> &dasharray, bool round);
 
+    // Memory held by the pixels and by the texture. Must be called on the render thread.
+    MemoryFootprint getMemoryFootprint() const;
+
     const int width;
     const int height;
 
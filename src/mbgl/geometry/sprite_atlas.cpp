@@ -1,14 +1,17 @@
 #include <mbgl/geometry/sprite_atlas.hpp>
 #include <mbgl/annotation/sprite_store.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/platform/platform.hpp>
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/scaling.hpp>
 #include <mbgl/util/thread_context.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <mbgl/map/sprite.hpp>
 
@@ -19,6 +22,13 @@
 
 using namespace mbgl;
 
+namespace {
+
+metrics::Gauge capacityPixels("sprite_atlas.capacity_pixels");
+metrics::Gauge usedPixels("sprite_atlas.used_pixels");
+
+}
+
 SpriteAtlas::SpriteAtlas(dimension width_, dimension height_, float pixelRatio_, SpriteStore& store_)
     : width(width_),
       height(height_),
@@ -30,6 +40,7 @@ SpriteAtlas::SpriteAtlas(dimension width_, dimension height_, float pixelRatio_,
       data(std::make_unique<uint32_t[]>(pixelWidth * pixelHeight)),
       dirty(true) {
     std::fill(data.get(), data.get() + pixelWidth * pixelHeight, 0);
+    capacityPixels.add(width * height);
 }
 
 Rect<SpriteAtlas::dimension> SpriteAtlas::allocateImage(const size_t pixel_width, const size_t pixel_height) {
@@ -46,6 +57,9 @@ Rect<SpriteAtlas::dimension> SpriteAtlas::allocateImage(const size_t pixel_width
         return rect;
     }
 
+    used += rect.w * rect.h;
+    usedPixels.add(rect.w * rect.h);
+
     rect.originalW = pixel_width;
     rect.originalH = pixel_height;
 
@@ -157,6 +171,10 @@ void SpriteAtlas::copy(const Holder& holder, const bool wrap) {
     dirty = true;
 }
 
+MemoryFootprint SpriteAtlas::getMemoryFootprint() const {
+    return { uint64_t(pixelWidth) * pixelHeight * 4, uint64_t(textureBytes) };
+}
+
 void SpriteAtlas::upload() {
     if (dirty) {
         bind();
@@ -215,8 +233,10 @@ void SpriteAtlas::bind(bool linear) {
     }
 
     if (dirty) {
+        MBGL_TRACE_SCOPE("gl", "sprite atlas upload");
         std::lock_guard<std::recursive_mutex> lock(mtx);
 
+        gl::stats::upload(pixelWidth * pixelHeight * 4);
         if (fullUploadRequired) {
             MBGL_CHECK_ERROR(glTexImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -229,6 +249,10 @@ void SpriteAtlas::bind(bool linear) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid * data
             ));
+            if (!textureBytes) {
+                textureBytes = pixelWidth * pixelHeight * 4;
+                metrics::gpuTextureBytes.add(textureBytes);
+            }
             fullUploadRequired = false;
         } else {
             MBGL_CHECK_ERROR(glTexSubImage2D(
@@ -259,6 +283,9 @@ SpriteAtlas::~SpriteAtlas() {
         mbgl::util::ThreadContext::getGLObjectStore()->abandonTexture(texture);
         texture = 0;
     }
+    metrics::gpuTextureBytes.subtract(textureBytes);
+    capacityPixels.subtract(width * height);
+    usedPixels.subtract(used);
 }
 
 SpriteAtlas::Holder::Holder(const std::shared_ptr<const SpriteImage>& texture_,
@@ -2,6 +2,7 @@
 #define MBGL_GEOMETRY_SPRITE_ATLAS
 
 #include <mbgl/geometry/binpack.hpp>
+#include <mbgl/map/memory_usage.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
@@ -61,6 +62,9 @@ public:
     // the texture is only bound when the data is out of date (=dirty).
     void upload();
 
+    // Memory held by the pixels and by the texture. Must be called on the render thread.
+    MemoryFootprint getMemoryFootprint() const;
+
     inline dimension getWidth() const { return width; }
     inline dimension getHeight() const { return height; }
     inline dimension getTextureWidth() const { return pixelWidth; }
@@ -88,12 +92,15 @@ private:
     std::recursive_mutex mtx;
     SpriteStore& store;
     BinPack<dimension> bin;
+    // Area of the images in the bin, in pixels.
+    int64_t used = 0;
     std::map<Key, Holder> images;
     std::set<std::string> uninitialized;
     const std::unique_ptr<uint32_t[]> data;
     std::atomic<bool> dirty;
     bool fullUploadRequired = true;
     uint32_t texture = 0;
+    int64_t textureBytes = 0;
     uint32_t filter = 0;
     static const int buffer = 1;
 };
@@ -0,0 +1,29 @@
+#include <mbgl/gl/stats.hpp>
+#include <mbgl/util/uv_detail.hpp>
+
+namespace mbgl {
+namespace gl {
+namespace stats {
+
+static uv::tls<Counters> current;
+
+void install(Counters* counters) {
+    current.set(counters);
+}
+
+void drawCall() {
+    if (auto counters = current.get()) {
+        counters->drawCalls++;
+    }
+}
+
+void upload(std::size_t bytes) {
+    if (auto counters = current.get()) {
+        counters->uploads++;
+        counters->bytesUploaded += bytes;
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,28 @@
+#ifndef MBGL_GL_STATS
+#define MBGL_GL_STATS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+namespace gl {
+namespace stats {
+
+// Counts the GL work issued on the current thread while a Counters object is installed. The
+// functions below are no-ops otherwise.
+struct Counters {
+    uint32_t drawCalls = 0;
+    uint32_t uploads = 0;
+    uint64_t bytesUploaded = 0;
+};
+
+void install(Counters*);
+
+void drawCall();
+void upload(std::size_t bytes);
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,491 @@
+#include <mbgl/map/bucket_cache.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/geometry/elements_buffer.hpp>
+#include <mbgl/platform/log.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace mbgl {
+
+namespace {
+
+const char magic[8] = { 'M', 'B', 'G', 'L', 'B', 'K', 'T', 0 };
+const uint32_t version = 2;
+const char extension[] = ".bucket";
+
+enum class BucketType : uint8_t {
+    Fill = 1,
+    Line = 2,
+};
+
+// Read-only mapping of a whole file.
+class MappedFile : private util::noncopyable {
+public:
+    MappedFile(const std::string& filename) {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                begin = reinterpret_cast<const char*>(mapped);
+                size = info.st_size;
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (begin) {
+            ::munmap(const_cast<char*>(begin), size);
+        }
+    }
+
+    const char* begin = nullptr;
+    std::size_t size = 0;
+};
+
+struct Groups {
+    std::vector<std::pair<uint32_t, uint32_t>> lengths;
+
+    template <typename Group>
+    static Groups from(const std::vector<std::unique_ptr<Group>>& groups) {
+        Groups result;
+        for (const auto& group : groups) {
+            result.lengths.emplace_back(group->vertex_length, group->elements_length);
+        }
+        return result;
+    }
+
+    template <typename Group>
+    void restore(std::vector<std::unique_ptr<Group>>& groups) const {
+        for (const auto& length : lengths) {
+            groups.emplace_back(std::make_unique<Group>(length.first, length.second));
+        }
+    }
+
+    uint64_t vertices() const {
+        uint64_t sum = 0;
+        for (const auto& length : lengths) sum += length.first;
+        return sum;
+    }
+
+    uint64_t elements() const {
+        uint64_t sum = 0;
+        for (const auto& length : lengths) sum += length.second;
+        return sum;
+    }
+};
+
+// Everything but the arrays that is needed to restore a bucket.
+struct Record {
+    BucketType type = BucketType::Fill;
+    std::string name;
+
+    uint32_t vertexStart = 0;
+    uint32_t triangleElementsStart = 0;
+    uint32_t lineElementsStart = 0;
+
+    Groups triangleGroups;
+    Groups lineGroups;
+
+    uint8_t cap = 0;
+    uint8_t join = 0;
+    float miterLimit = 0;
+    float roundLimit = 0;
+};
+
+class Writer {
+public:
+    template <typename T>
+    void write(const T& value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeBytes(const void* bytes, std::size_t length) {
+        write<uint64_t>(length);
+        if (length) {
+            data.append(reinterpret_cast<const char*>(bytes), length);
+        }
+    }
+
+    void writeGroups(const Groups& groups) {
+        write<uint32_t>(groups.lengths.size());
+        for (const auto& length : groups.lengths) {
+            write<uint32_t>(length.first);
+            write<uint32_t>(length.second);
+        }
+    }
+
+    std::string data;
+};
+
+// Bounds checked reads from the mapped file. Any read past the end marks the reader as failed
+// and returns zeroes.
+class Reader {
+public:
+    Reader(const char* begin, std::size_t size) : pos(begin), end(begin + size) {}
+
+    template <typename T>
+    T read() {
+        T value {};
+        if (std::size_t(end - pos) < sizeof(T)) {
+            failed = true;
+            return value;
+        }
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::pair<const char*, std::size_t> readBytes() {
+        const auto length = read<uint64_t>();
+        if (failed || std::size_t(end - pos) < length) {
+            failed = true;
+            return { nullptr, 0 };
+        }
+        const char* bytes = pos;
+        pos += length;
+        return { bytes, length };
+    }
+
+    Groups readGroups() {
+        Groups groups;
+        const auto count = read<uint32_t>();
+        for (uint32_t i = 0; i < count && !failed; i++) {
+            const auto vertexLength = read<uint32_t>();
+            const auto elementsLength = read<uint32_t>();
+            groups.lengths.emplace_back(vertexLength, elementsLength);
+        }
+        return groups;
+    }
+
+    bool failed = false;
+
+private:
+    const char* pos;
+    const char* const end;
+};
+
+// A cached array and the buffer that it is restored into. Items are copied as they are needed,
+// so that every bucket is constructed at the buffer position that it was originally created at.
+template <typename Buffer>
+class CachedArray {
+public:
+    CachedArray(Buffer& buffer_, std::pair<const char*, std::size_t> array_)
+        : buffer(buffer_), array(array_), items(array.second / Buffer::itemSize) {}
+
+    bool isValid() const {
+        return array.second % Buffer::itemSize == 0;
+    }
+
+    // Checks that a bucket starts after the previous bucket in the same buffer, and that
+    // `count` items follow its start.
+    bool check(uint64_t start, uint64_t count) {
+        if (start < lastStart || start + count > items) {
+            return false;
+        }
+        lastStart = start;
+        return true;
+    }
+
+    // Copies the items before `start`.
+    void copyUntil(uint64_t start) {
+        const std::size_t copied = buffer.bytes();
+        buffer.append(array.first + copied, start * Buffer::itemSize - copied);
+    }
+
+    void finish() {
+        copyUntil(items);
+    }
+
+private:
+    Buffer& buffer;
+    const std::pair<const char*, std::size_t> array;
+    const uint64_t items;
+    uint64_t lastStart = 0;
+};
+
+} // namespace
+
+BucketCache::BucketCache(std::string path_, uint64_t maxSize_, std::size_t layoutHash_)
+    : path(std::move(path_)), maxSize(maxSize_), layoutHash(layoutHash_) {
+}
+
+std::string BucketCache::fileName(const std::string& sourceID, const TileID& id, std::size_t dataHash) const {
+    std::size_t hash = std::hash<std::string>()(sourceID);
+    hash ^= layoutHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= dataHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    char name[64];
+    snprintf(name, sizeof(name), "/%016llx-%016llx%s",
+             static_cast<unsigned long long>(id.key()),
+             static_cast<unsigned long long>(hash), extension);
+    return path + name;
+}
+
+bool BucketCache::load(const std::string& sourceID, const TileID& id, std::size_t dataHash,
+                       Buffers& buffers, Buckets& buckets) const {
+    assert(buffers.fillVertex.empty() && buffers.lineVertex.empty());
+    assert(buffers.triangleElements.empty() && buffers.lineElements.empty());
+
+    const std::string filename = fileName(sourceID, id, dataHash);
+    const MappedFile file(filename);
+    if (!file.begin) {
+        return false;
+    }
+
+    Reader reader(file.begin, file.size);
+    char fileMagic[sizeof(magic)];
+    for (auto& c : fileMagic) {
+        c = reader.read<char>();
+    }
+    if (std::memcmp(fileMagic, magic, sizeof(magic)) != 0 || reader.read<uint32_t>() != version ||
+        reader.read<uint64_t>() != layoutHash || reader.read<uint64_t>() != id.key() ||
+        reader.read<uint64_t>() != dataHash) {
+        return false;
+    }
+    const auto fileSourceID = reader.readBytes();
+    if (reader.failed || std::string(fileSourceID.first, fileSourceID.second) != sourceID) {
+        return false;
+    }
+
+    CachedArray<FillVertexBuffer> fillVertex(buffers.fillVertex, reader.readBytes());
+    CachedArray<LineVertexBuffer> lineVertex(buffers.lineVertex, reader.readBytes());
+    CachedArray<TriangleElementsBuffer> triangleElements(buffers.triangleElements, reader.readBytes());
+    CachedArray<LineElementsBuffer> lineElements(buffers.lineElements, reader.readBytes());
+
+    // Read and check all records before touching the buffers, so that a damaged file leaves
+    // the tile untouched.
+    std::vector<Record> records;
+    bool valid = !reader.failed && fillVertex.isValid() && lineVertex.isValid() &&
+                 triangleElements.isValid() && lineElements.isValid();
+    const auto count = valid ? reader.read<uint32_t>() : 0;
+    for (uint32_t i = 0; i < count && valid; i++) {
+        Record record;
+        record.type = BucketType(reader.read<uint8_t>());
+        const auto name = reader.readBytes();
+        record.name.assign(name.first, name.second);
+        record.vertexStart = reader.read<uint32_t>();
+        record.triangleElementsStart = reader.read<uint32_t>();
+
+        if (record.type == BucketType::Fill) {
+            record.lineElementsStart = reader.read<uint32_t>();
+            record.triangleGroups = reader.readGroups();
+            record.lineGroups = reader.readGroups();
+            valid = !reader.failed &&
+                fillVertex.check(record.vertexStart, std::max(record.triangleGroups.vertices(),
+                                                              record.lineGroups.vertices())) &&
+                triangleElements.check(record.triangleElementsStart, record.triangleGroups.elements()) &&
+                lineElements.check(record.lineElementsStart, record.lineGroups.elements());
+        } else if (record.type == BucketType::Line) {
+            record.cap = reader.read<uint8_t>();
+            record.join = reader.read<uint8_t>();
+            record.miterLimit = reader.read<float>();
+            record.roundLimit = reader.read<float>();
+            record.triangleGroups = reader.readGroups();
+            valid = !reader.failed &&
+                lineVertex.check(record.vertexStart, record.triangleGroups.vertices()) &&
+                triangleElements.check(record.triangleElementsStart, record.triangleGroups.elements());
+        } else {
+            valid = false;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    if (!valid || reader.failed) {
+        Log::Warning(Event::ParseTile, "ignoring invalid cached buckets of tile %d/%d/%d",
+                     id.z, id.x, id.y);
+        return false;
+    }
+
+    for (const auto& record : records) {
+        if (record.type == BucketType::Fill) {
+            fillVertex.copyUntil(record.vertexStart);
+            triangleElements.copyUntil(record.triangleElementsStart);
+            lineElements.copyUntil(record.lineElementsStart);
+
+            auto bucket = std::make_unique<FillBucket>(buffers.fillVertex, buffers.triangleElements, buffers.lineElements);
+            record.triangleGroups.restore(bucket->triangleGroups);
+            record.lineGroups.restore(bucket->lineGroups);
+            buckets[record.name] = std::move(bucket);
+        } else {
+            lineVertex.copyUntil(record.vertexStart);
+            triangleElements.copyUntil(record.triangleElementsStart);
+
+            auto bucket = std::make_unique<LineBucket>(buffers.lineVertex, buffers.triangleElements);
+            bucket->layout.cap = CapType(record.cap);
+            bucket->layout.join = JoinType(record.join);
+            bucket->layout.miter_limit = record.miterLimit;
+            bucket->layout.round_limit = record.roundLimit;
+            record.triangleGroups.restore(bucket->triangleGroups);
+            buckets[record.name] = std::move(bucket);
+        }
+    }
+
+    fillVertex.finish();
+    lineVertex.finish();
+    triangleElements.finish();
+    lineElements.finish();
+
+    // Mark the file as recently used.
+    ::utimes(filename.c_str(), nullptr);
+
+    return true;
+}
+
+void BucketCache::save(const std::string& sourceID, const TileID& id, std::size_t dataHash,
+                       const Buffers& buffers, const Buckets& buckets) const {
+    std::vector<Record> records;
+    for (const auto& entry : buckets) {
+        Record record;
+        record.name = entry.first;
+        if (const auto fill = dynamic_cast<const FillBucket*>(entry.second.get())) {
+            record.type = BucketType::Fill;
+            record.vertexStart = fill->vertex_start;
+            record.triangleElementsStart = fill->triangle_elements_start;
+            record.lineElementsStart = fill->line_elements_start;
+            record.triangleGroups = Groups::from(fill->triangleGroups);
+            record.lineGroups = Groups::from(fill->lineGroups);
+        } else if (const auto line = dynamic_cast<const LineBucket*>(entry.second.get())) {
+            record.type = BucketType::Line;
+            record.vertexStart = line->vertex_start;
+            record.triangleElementsStart = line->triangle_elements_start;
+            record.cap = uint8_t(line->layout.cap);
+            record.join = uint8_t(line->layout.join);
+            record.miterLimit = line->layout.miter_limit;
+            record.roundLimit = line->layout.round_limit;
+            record.triangleGroups = Groups::from(line->triangleGroups);
+        } else {
+            continue;
+        }
+        records.push_back(std::move(record));
+    }
+
+    // Restore the creation order of the buckets: every buffer is filled front to back, and fill
+    // and line buckets only share the triangle elements.
+    std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return std::tie(a.triangleElementsStart, a.type, a.vertexStart, a.lineElementsStart) <
+               std::tie(b.triangleElementsStart, b.type, b.vertexStart, b.lineElementsStart);
+    });
+
+    Writer writer;
+    for (const char c : magic) {
+        writer.write(c);
+    }
+    writer.write(version);
+    writer.write<uint64_t>(layoutHash);
+    writer.write<uint64_t>(id.key());
+    writer.write<uint64_t>(dataHash);
+    writer.writeBytes(sourceID.data(), sourceID.size());
+    writer.writeBytes(buffers.fillVertex.data(), buffers.fillVertex.bytes());
+    writer.writeBytes(buffers.lineVertex.data(), buffers.lineVertex.bytes());
+    writer.writeBytes(buffers.triangleElements.data(), buffers.triangleElements.bytes());
+    writer.writeBytes(buffers.lineElements.data(), buffers.lineElements.bytes());
+
+    writer.write<uint32_t>(records.size());
+    for (const auto& record : records) {
+        writer.write(uint8_t(record.type));
+        writer.writeBytes(record.name.data(), record.name.size());
+        writer.write(record.vertexStart);
+        writer.write(record.triangleElementsStart);
+        if (record.type == BucketType::Fill) {
+            writer.write(record.lineElementsStart);
+            writer.writeGroups(record.triangleGroups);
+            writer.writeGroups(record.lineGroups);
+        } else {
+            writer.write(record.cap);
+            writer.write(record.join);
+            writer.write(record.miterLimit);
+            writer.write(record.roundLimit);
+            writer.writeGroups(record.triangleGroups);
+        }
+    }
+
+    // Write to a temporary file first, so that other workers never map a partial file.
+    const std::string filename = fileName(sourceID, id, dataHash);
+    const std::string temporary = filename + "." + std::to_string(reinterpret_cast<uintptr_t>(&buffers));
+    try {
+        util::write_file(temporary, writer.data);
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            util::deleteFile(temporary);
+        }
+    } catch (const std::exception& ex) {
+        Log::Warning(Event::ParseTile, "failed to cache buckets of tile %d/%d/%d: %s",
+                     id.z, id.x, id.y, ex.what());
+        return;
+    }
+
+    prune();
+}
+
+void BucketCache::prune() const {
+    // Saving is rare next to loading and parsing, so listing the directory every time is cheap
+    // enough. Several caches may prune the same directory at once; files that another one
+    // deleted first are skipped.
+    DIR* const dir = ::opendir(path.c_str());
+    if (!dir) {
+        return;
+    }
+
+    struct File {
+        std::string name;
+        time_t used;
+        uint64_t size;
+    };
+    std::vector<File> files;
+    uint64_t total = 0;
+
+    const std::size_t extensionLength = sizeof(extension) - 1;
+    while (const dirent* entry = ::readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.size() <= extensionLength ||
+            name.compare(name.size() - extensionLength, extensionLength, extension) != 0) {
+            continue;
+        }
+        const std::string filename = path + "/" + name;
+        struct stat info;
+        if (::stat(filename.c_str(), &info) == 0) {
+            files.push_back({ filename, info.st_mtime, uint64_t(info.st_size) });
+            total += info.st_size;
+        }
+    }
+    ::closedir(dir);
+
+    if (total <= maxSize) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const File& a, const File& b) {
+        return a.used < b.used;
+    });
+    for (const auto& file : files) {
+        if (total <= maxSize) {
+            break;
+        }
+        if (::unlink(file.name.c_str()) == 0) {
+            total -= file.size;
+        }
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,65 @@
+#ifndef MBGL_MAP_BUCKET_CACHE
+#define MBGL_MAP_BUCKET_CACHE
+
+#include <mbgl/map/tile_id.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+class Bucket;
+class FillVertexBuffer;
+class LineVertexBuffer;
+class TriangleElementsBuffer;
+class LineElementsBuffer;
+
+// Stores the fill and line buckets of parsed tiles on disk, as the raw vertex and element
+// arrays of the tile plus the group layout of every bucket. Loading a tile maps the file and
+// copies the arrays into the tile's buffers, skipping geometry decoding, tessellation and
+// line extrusion. Symbol buckets depend on glyphs and placement and are always parsed.
+//
+// Entries are keyed by source, tile (which includes the overscaling), a hash of the raw tile
+// data and a hash of the style layout, so a tile whose data changed on the server misses the
+// cache. Files are written with the native byte order and are rejected when they don't match
+// the key, e.g. after a hash collision.
+//
+// Loading a tile marks its file as used. Saving a tile deletes the least recently used files
+// while the files in the directory are larger than the maximum size.
+class BucketCache : private util::noncopyable {
+public:
+    struct Buffers {
+        FillVertexBuffer& fillVertex;
+        LineVertexBuffer& lineVertex;
+        TriangleElementsBuffer& triangleElements;
+        LineElementsBuffer& lineElements;
+    };
+
+    using Buckets = std::unordered_map<std::string, std::unique_ptr<Bucket>>;
+
+    BucketCache(std::string path, uint64_t maxSize, std::size_t layoutHash);
+
+    // Restores the cached buckets of the tile into the empty buffers. Returns false when the
+    // tile is not cached or the file can't be used, in which case nothing was changed.
+    bool load(const std::string& sourceID, const TileID&, std::size_t dataHash, Buffers&, Buckets&) const;
+
+    // Writes the fill and line buckets of the tile. Must be called before the buffers are
+    // uploaded.
+    void save(const std::string& sourceID, const TileID&, std::size_t dataHash, const Buffers&, const Buckets&) const;
+
+private:
+    std::string fileName(const std::string& sourceID, const TileID&, std::size_t dataHash) const;
+
+    // Deletes the least recently used files until the directory is no larger than maxSize.
+    void prune() const;
+
+    const std::string path;
+    const uint64_t maxSize;
+    const std::size_t layoutHash;
+};
+
+}
+
+#endif
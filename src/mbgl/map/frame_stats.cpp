@@ -0,0 +1,27 @@
+#include <mbgl/map/frame_stats.hpp>
+
+#include <numeric>
+
+namespace mbgl {
+
+const char* FrameStats::passName(Pass pass) {
+    switch (pass) {
+        case Upload: return "upload";
+        case TileCache: return "tile cache";
+        case Clipping: return "clipping";
+        case Opaque: return "opaque";
+        case Translucent: return "translucent";
+        case Debug: return "debug";
+        default: return "";
+    }
+}
+
+Duration FrameStats::totalCPUTime() const {
+    return std::accumulate(cpuTime.begin(), cpuTime.end(), Duration::zero());
+}
+
+Duration FrameStats::totalGPUTime() const {
+    return std::accumulate(gpuTime.begin(), gpuTime.end(), Duration::zero());
+}
+
+}
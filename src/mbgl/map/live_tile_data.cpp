@@ -38,6 +38,7 @@ LiveTileData::LiveTileData(const TileID& id_,
     workRequest = worker.parseLiveTile(tileWorker, *tile, [this, callback] (TileParseResult result) {
         if (result.is<State>()) {
             state = result.get<State>();
+            updateRevision();
         } else {
             error = result.get<std::string>();
             state = State::obsolete;
@@ -59,6 +60,14 @@ Bucket* LiveTileData::getBucket(const StyleLayer& layer) {
     return tileWorker.getBucket(layer);
 }
 
+MemoryFootprint LiveTileData::getMemoryFootprint() const {
+    MemoryFootprint footprint = TileData::getMemoryFootprint();
+    if (isReady()) {
+        footprint += tileWorker.getMemoryFootprint();
+    }
+    return footprint;
+}
+
 void LiveTileData::cancel() {
     state = State::obsolete;
     workRequest.reset();
@@ -22,6 +22,7 @@ public:
 
     void cancel() override;
     Bucket* getBucket(const StyleLayer&) override;
+    MemoryFootprint getMemoryFootprint() const override;
 
 private:
     Worker& worker;
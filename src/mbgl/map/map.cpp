@@ -429,8 +429,57 @@ void Map::setSourceTileCacheSize(size_t size) {
     context->invoke(&MapContext::setSourceTileCacheSize, size);
 }
 
-void Map::onLowMemory() {
-    context->invoke(&MapContext::onLowMemory);
+void Map::setSharedWorkers(bool value) {
+    data->setSharedWorkers(value);
+}
+
+bool Map::getSharedWorkers() const {
+    return data->getSharedWorkers();
+}
+
+void Map::setBucketCachePath(const std::string& path, uint64_t maxSize) {
+    data->setBucketCachePath(path, maxSize);
+}
+
+std::string Map::getBucketCachePath() const {
+    return data->getBucketCachePath();
+}
+
+void Map::setTileLOD(const TileLOD& lod) {
+    data->setTileLOD(lod);
+    update();
+}
+
+TileLOD Map::getTileLOD() const {
+    return data->getTileLOD();
+}
+
+void Map::setTileRenderCacheSize(size_t size) {
+    context->invoke(&MapContext::setTileRenderCacheSize, size);
+}
+
+FrameStats Map::getLastFrameStats() const {
+    return context->invokeSync<FrameStats>(&MapContext::getLastFrameStats);
+}
+
+void Map::setFrameStatsHistorySize(size_t frames) {
+    context->invoke(&MapContext::setFrameStatsHistorySize, frames);
+}
+
+std::vector<FrameStats> Map::getFrameStatsHistory() const {
+    return context->invokeSync<std::vector<FrameStats>>(&MapContext::getFrameStatsHistory);
+}
+
+metrics::Snapshot Map::getMetrics() const {
+    return metrics::snapshot();
+}
+
+MemoryUsage Map::getMemoryUsage() const {
+    return context->invokeSync<MemoryUsage>(&MapContext::getMemoryUsage);
+}
+
+void Map::onLowMemory(uint64_t bytes) {
+    context->invoke(&MapContext::onLowMemory, bytes);
 }
 
 }
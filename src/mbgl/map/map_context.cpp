@@ -13,17 +13,22 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 
+#include <mbgl/geometry/glyph_atlas.hpp>
+#include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/geometry/sprite_atlas.hpp>
 
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_bucket.hpp>
 #include <mbgl/style/style_layer.hpp>
 
+#include <mbgl/text/glyph_store.hpp>
+
 #include <mbgl/util/gl_object_store.hpp>
 #include <mbgl/util/uv_detail.hpp>
 #include <mbgl/util/worker.hpp>
 #include <mbgl/util/texture_pool.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <algorithm>
 
@@ -224,6 +229,11 @@ void MapContext::updateAnnotationTiles(const std::unordered_set<TileID, TileID::
         }
     }
 
+    // Annotation layers may be part of the cached tiles.
+    if (painter) {
+        painter->clearTileRenderCache();
+    }
+
     // invalidate annotations layer tiles
     for (const auto &source : style->sources) {
         if (source->info.type == SourceType::Annotations) {
@@ -245,6 +255,7 @@ void MapContext::cascadeClasses() {
 
 void MapContext::update() {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    MBGL_TRACE_SCOPE("map", "update");
 
     const auto now = Clock::now();
     data.setAnimationTime(now);
@@ -305,12 +316,19 @@ void MapContext::renderStill(const TransformState& state, const FrameData& frame
     transformState = state;
     frameData = frame;
 
+    // Request glyphs in parallel with the tiles so that symbol layers don't have to wait for a
+    // partial parse followed by a reparse once the glyphs arrive. The image is only rendered
+    // once they are loaded.
+    style->prefetchGlyphs(transformState.getNormalizedZoom());
+
+    // Rendering synchronously could invoke the callback before renderStill() returns.
     updated |= static_cast<UpdateType>(Update::RenderStill);
     asyncUpdate->send();
 }
 
 MapContext::RenderResult MapContext::renderSync(const TransformState& state, const FrameData& frame) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    MBGL_TRACE_SCOPE("map", "render");
 
     // Style was not loaded yet.
     if (!style) {
@@ -325,6 +343,8 @@ MapContext::RenderResult MapContext::renderSync(const TransformState& state, con
     if (!painter) {
         painter = std::make_unique<Painter>(data.pixelRatio);
         painter->setup();
+        painter->setTileRenderCacheSize(tileRenderCacheSize);
+        painter->frameProfiler.setHistorySize(frameStatsHistorySize);
     }
 
     painter->setDebug(data.getDebug());
@@ -369,12 +389,80 @@ void MapContext::setSourceTileCacheSize(size_t size) {
     }
 }
 
-void MapContext::onLowMemory() {
+void MapContext::setTileRenderCacheSize(size_t size) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
-    if (!style) return;
+    if (data.mode != MapMode::Still) {
+        Log::Warning(Event::General, "The tile render cache is only available in still mode");
+        return;
+    }
+
+    tileRenderCacheSize = size;
+    if (painter) {
+        painter->setTileRenderCacheSize(tileRenderCacheSize);
+    }
+}
+
+FrameStats MapContext::getLastFrameStats() const {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    return painter ? painter->frameProfiler.getLastFrame() : FrameStats();
+}
+
+void MapContext::setFrameStatsHistorySize(size_t size) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    frameStatsHistorySize = size;
+    if (painter) {
+        painter->frameProfiler.setHistorySize(frameStatsHistorySize);
+    }
+}
+
+std::vector<FrameStats> MapContext::getFrameStatsHistory() const {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    return painter ? painter->frameProfiler.getHistory() : std::vector<FrameStats>();
+}
+
+MemoryUsage MapContext::getMemoryUsage() const {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    MemoryUsage usage;
+
+    usage.categories[MemoryUsage::TexturePool] = texturePool->getMemoryFootprint();
+    if (painter) {
+        usage.categories[MemoryUsage::TileRenderCache] = painter->getTileRenderCacheFootprint();
+    }
+
+    if (!style) return usage;
     for (const auto &source : style->sources) {
-        source->onLowMemory();
+        source->addMemoryUsage(usage);
+    }
+    usage.categories[MemoryUsage::GlyphAtlas] = style->glyphAtlas->getMemoryFootprint();
+    usage.categories[MemoryUsage::SpriteAtlas] = style->spriteAtlas->getMemoryFootprint();
+    usage.categories[MemoryUsage::LineAtlas] = style->lineAtlas->getMemoryFootprint();
+    usage.categories[MemoryUsage::FontStacks] = style->glyphStore->getMemoryFootprint();
+
+    return usage;
+}
+
+void MapContext::onLowMemory(uint64_t bytes) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+
+    for (const auto category : getMemoryUsage().reclaimOrder(bytes)) {
+        switch (category) {
+        case MemoryUsage::TileCache:
+            for (const auto &source : style->sources) {
+                source->onLowMemory();
+            }
+            break;
+        case MemoryUsage::TileRenderCache:
+            painter->clearTileRenderCache();
+            break;
+        case MemoryUsage::TexturePool:
+            texturePool->clearTextureIDs();
+            break;
+        default:
+            assert(false);
+            break;
+        }
     }
+
     view.invalidate();
 }
 
@@ -386,11 +474,23 @@ void MapContext::setSprite(const std::string& name, std::shared_ptr<const Sprite
 
     style->spriteStore->setSprite(name, sprite);
 
+    // Fill patterns may use the sprite.
+    if (painter) {
+        painter->clearTileRenderCache();
+    }
+
     style->spriteAtlas->updateDirty();
 }
 
 void MapContext::onTileDataChanged() {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+
+    // In still mode, there is nothing to do unless a still image was requested. Pending work
+    // such as reparsing partial tiles is picked up by the update in renderStill().
+    if (data.mode == MapMode::Still && !callback) {
+        return;
+    }
+
     asyncUpdate->send();
 }
 
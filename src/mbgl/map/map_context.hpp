@@ -2,6 +2,8 @@
 #define MBGL_MAP_MAP_CONTEXT
 
 #include <mbgl/map/tile_id.hpp>
+#include <mbgl/map/frame_stats.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/map/update.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/style/style.hpp>
@@ -61,7 +63,14 @@ public:
     void updateAnnotationTiles(const std::unordered_set<TileID, TileID::Hash>&);
 
     void setSourceTileCacheSize(size_t size);
-    void onLowMemory();
+    void setTileRenderCacheSize(size_t size);
+
+    FrameStats getLastFrameStats() const;
+    void setFrameStatsHistorySize(size_t size);
+    std::vector<FrameStats> getFrameStatsHistory() const;
+
+    MemoryUsage getMemoryUsage() const;
+    void onLowMemory(uint64_t bytes);
 
     void cleanup();
 
@@ -100,6 +109,8 @@ private:
 
     StillImageCallback callback;
     size_t sourceCacheSize;
+    size_t tileRenderCacheSize = 0;
+    size_t frameStatsHistorySize = 0;
     TransformState transformState;
     FrameData frameData;
 };
@@ -41,4 +41,30 @@ std::vector<std::string> MapData::getClasses() const {
     return classes;
 }
 
+TileLOD MapData::getTileLOD() const {
+    Lock lock(mtx);
+    return tileLOD;
+}
+
+void MapData::setTileLOD(const TileLOD& lod) {
+    Lock lock(mtx);
+    tileLOD = lod;
+}
+
+std::string MapData::getBucketCachePath() const {
+    Lock lock(mtx);
+    return bucketCachePath;
+}
+
+uint64_t MapData::getBucketCacheMaxSize() const {
+    Lock lock(mtx);
+    return bucketCacheMaxSize;
+}
+
+void MapData::setBucketCachePath(const std::string& path, uint64_t maxSize) {
+    Lock lock(mtx);
+    bucketCachePath = path;
+    bucketCacheMaxSize = maxSize;
+}
+
 }
@@ -11,6 +11,7 @@
 #include <condition_variable>
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/tile_lod.hpp>
 #include <mbgl/map/annotation.hpp>
 #include <mbgl/util/exclusive.hpp>
 
@@ -43,6 +44,13 @@ public:
     // Returns a list of all currently set classes.
     std::vector<std::string> getClasses() const;
 
+    TileLOD getTileLOD() const;
+    void setTileLOD(const TileLOD&);
+
+    std::string getBucketCachePath() const;
+    uint64_t getBucketCacheMaxSize() const;
+    void setBucketCachePath(const std::string&, uint64_t maxSize);
+
 
     inline bool getDebug() const {
         return debug;
@@ -64,6 +72,13 @@ public:
         collisionDebug = value;
     }
 
+    inline bool getSharedWorkers() const {
+        return sharedWorkers;
+    }
+    inline void setSharedWorkers(bool value) {
+        sharedWorkers = value;
+    }
+
     inline TimePoint getAnimationTime() const {
         // We're casting the TimePoint to and from a Duration because libstdc++
         // has a bug that doesn't allow TimePoints to be atomic.
@@ -97,8 +112,12 @@ private:
     mutable std::mutex mtx;
 
     std::vector<std::string> classes;
+    TileLOD tileLOD;
+    std::string bucketCachePath;
+    uint64_t bucketCacheMaxSize = 0;
     std::atomic<uint8_t> debug { false };
     std::atomic<uint8_t> collisionDebug { false };
+    std::atomic<uint8_t> sharedWorkers { false };
     std::atomic<Duration> animationTime;
     std::atomic<Duration> defaultTransitionDuration;
 
@@ -0,0 +1,59 @@
+#include <mbgl/map/memory_usage.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+const char* MemoryUsage::categoryName(Category category) {
+    switch (category) {
+        case Tiles: return "tiles";
+        case TileCache: return "tile cache";
+        case TileRenderCache: return "tile render cache";
+        case TexturePool: return "texture pool";
+        case GlyphAtlas: return "glyph atlas";
+        case SpriteAtlas: return "sprite atlas";
+        case LineAtlas: return "line atlas";
+        case FontStacks: return "font stacks";
+        default: return "";
+    }
+}
+
+bool MemoryUsage::isReclaimable(Category category) {
+    // The atlases and font stacks hold what the loaded tiles refer to, and the tiles in use
+    // are needed for the next frame.
+    return category == TileCache || category == TileRenderCache || category == TexturePool;
+}
+
+MemoryFootprint MemoryUsage::total() const {
+    MemoryFootprint result;
+    for (const auto& category : categories) {
+        result += category;
+    }
+    return result;
+}
+
+std::vector<MemoryUsage::Category> MemoryUsage::reclaimOrder(uint64_t bytes) const {
+    std::vector<Category> order;
+    for (uint8_t i = 0; i < CategoryCount; i++) {
+        if (isReclaimable(Category(i)) && categories[i].total() > 0) {
+            order.push_back(Category(i));
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](Category a, Category b) {
+        return categories[a].total() > categories[b].total();
+    });
+
+    uint64_t released = 0;
+    for (auto it = order.begin(); it != order.end(); ++it) {
+        if (released >= bytes) {
+            order.erase(it, order.end());
+            break;
+        }
+        released += categories[*it].total();
+    }
+
+    return order;
+}
+
+}
@@ -0,0 +1,122 @@
+#include <mbgl/map/metatile.hpp>
+#include <mbgl/map/still_image.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+uint16_t clampedTileCount(uint8_t z, uint32_t first, uint16_t size) {
+    const uint32_t dim = 1u << z;
+    if (first >= dim) {
+        throw std::out_of_range("metatile is outside of the world");
+    }
+    return std::min<uint32_t>(size, dim - first);
+}
+
+}
+
+Metatile::Metatile(uint8_t z_, uint32_t x_, uint32_t y_, uint16_t size,
+                   uint16_t tileSize_, uint16_t buffer_)
+    : z(z_),
+      x(x_),
+      y(y_),
+      columns(clampedTileCount(z_, x_, std::max<uint16_t>(size, 1))),
+      rows(clampedTileCount(z_, y_, std::max<uint16_t>(size, 1))),
+      tileSize(tileSize_),
+      buffer(buffer_) {
+    if (getWidth() > maxDimension || getHeight() > maxDimension) {
+        throw std::invalid_argument("metatile is too large to be rendered");
+    }
+}
+
+uint32_t Metatile::getWidth() const {
+    return uint32_t(columns) * tileSize + 2 * uint32_t(buffer);
+}
+
+uint32_t Metatile::getHeight() const {
+    return uint32_t(rows) * tileSize + 2 * uint32_t(buffer);
+}
+
+uint32_t Metatile::getFramebufferWidth(float pixelRatio) const {
+    // Views truncate their physical size.
+    return getWidth() * pixelRatio;
+}
+
+uint32_t Metatile::getFramebufferHeight(float pixelRatio) const {
+    return getHeight() * pixelRatio;
+}
+
+void Metatile::checkFramebufferSize(float pixelRatio, uint32_t maxFramebufferSize) const {
+    if (getFramebufferWidth(pixelRatio) > maxFramebufferSize ||
+        getFramebufferHeight(pixelRatio) > maxFramebufferSize) {
+        throw std::invalid_argument("metatile is too large to be rendered at this pixel ratio");
+    }
+}
+
+LatLng Metatile::getCenter() const {
+    // Center of the block in tile coordinates at zoom level z.
+    const double dim = std::pow(2.0, z);
+    const double cx = x + columns / 2.0;
+    const double cy = y + rows / 2.0;
+
+    const double n = M_PI - 2.0 * M_PI * cy / dim;
+    return {
+        util::RAD2DEG * std::atan(0.5 * (std::exp(n) - std::exp(-n))),
+        cx / dim * 360.0 - 180.0
+    };
+}
+
+double Metatile::getZoom() const {
+    // The map's zoom levels are based on util::tileSize, so tiles of a different
+    // size need to be rendered at an offset zoom level.
+    return z + std::log2(tileSize / util::tileSize);
+}
+
+std::vector<std::unique_ptr<StillImage>> Metatile::slice(const StillImage& image) const {
+    assert(image.pixels);
+
+    const float pixelRatio = float(image.width) / getWidth();
+    const uint32_t tilePixels = std::round(tileSize * pixelRatio);
+    const uint32_t bufferPixels = std::round(buffer * pixelRatio);
+
+    if (bufferPixels + columns * tilePixels > image.width ||
+        bufferPixels + rows * tilePixels > image.height) {
+        throw std::invalid_argument("image is too small for metatile");
+    }
+
+    std::vector<std::unique_ptr<StillImage>> tiles;
+    tiles.reserve(columns * rows);
+
+    for (uint16_t row = 0; row < rows; ++row) {
+        for (uint16_t column = 0; column < columns; ++column) {
+            auto tile = std::make_unique<StillImage>();
+            tile->width = tilePixels;
+            tile->height = tilePixels;
+            tile->pixels = std::make_unique<StillImage::Pixel[]>(tilePixels * tilePixels);
+
+            const StillImage::Pixel* src = image.pixels.get() +
+                (bufferPixels + row * tilePixels) * image.width +
+                bufferPixels + column * tilePixels;
+            StillImage::Pixel* dst = tile->pixels.get();
+
+            for (uint32_t i = 0; i < tilePixels; ++i) {
+                std::memcpy(dst, src, tilePixels * sizeof(StillImage::Pixel));
+                src += image.width;
+                dst += tilePixels;
+            }
+
+            tiles.emplace_back(std::move(tile));
+        }
+    }
+
+    return tiles;
+}
+
+}
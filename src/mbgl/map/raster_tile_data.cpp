@@ -51,6 +51,7 @@ void RasterTileData::request(float pixelRatio,
 
             if (result.is<State>()) {
                 state = result.get<State>();
+                updateRevision();
             } else {
                 std::stringstream message;
                 message << "Failed to parse [" << std::string(id) << "]: " << result.get<std::string>();
@@ -67,6 +68,12 @@ Bucket* RasterTileData::getBucket(StyleLayer const&) {
     return &bucket;
 }
 
+MemoryFootprint RasterTileData::getMemoryFootprint() const {
+    MemoryFootprint footprint = TileData::getMemoryFootprint();
+    footprint += bucket.getMemoryFootprint();
+    return footprint;
+}
+
 void RasterTileData::cancel() {
     if (state != State::obsolete) {
         state = State::obsolete;
@@ -24,6 +24,7 @@ public:
     void cancel() override;
 
     Bucket* getBucket(StyleLayer const &layer_desc) override;
+    MemoryFootprint getMemoryFootprint() const override;
 
 private:
     const SourceInfo& source;
@@ -0,0 +1,56 @@
+#include <mbgl/map/shared_tile_store.hpp>
+#include <mbgl/map/vector_tile.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+SharedTileStore& SharedTileStore::get() {
+    static SharedTileStore store;
+    return store;
+}
+
+std::shared_ptr<const SharedVectorTile> SharedTileStore::find(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = tiles.find(url);
+    if (it == tiles.end()) {
+        return nullptr;
+    }
+
+    auto tile = it->second.lock();
+    if (!tile) {
+        tiles.erase(it);
+    }
+    return tile;
+}
+
+void SharedTileStore::add(const std::string& url, std::shared_ptr<const SharedVectorTile> tile) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    tiles[url] = tile;
+
+    // Expired entries are only dropped in batches, so that adding a tile stays cheap.
+    if (tiles.size() >= pruneThreshold) {
+        prune();
+        pruneThreshold = std::max<std::size_t>(64, tiles.size() * 2);
+    }
+}
+
+std::size_t SharedTileStore::size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    prune();
+    return tiles.size();
+}
+
+void SharedTileStore::prune() {
+    for (auto it = tiles.begin(); it != tiles.end();) {
+        if (it->second.expired()) {
+            it = tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}
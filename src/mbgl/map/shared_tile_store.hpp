@@ -0,0 +1,46 @@
+#ifndef MBGL_MAP_SHARED_TILE_STORE
+#define MBGL_MAP_SHARED_TILE_STORE
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+class SharedVectorTile;
+
+// Process-wide registry of the vector tiles that are currently loaded by any Map. Tiles are
+// keyed by their URL, which identifies both the source and the tile, and are only referenced
+// weakly: an entry lives as long as at least one Map holds on to the tile. Maps that show the
+// same source then download and decode every tile only once.
+//
+// Parsed buckets are not shared, because they own GL buffers of the Map's own context and
+// depend on the Map's style.
+class SharedTileStore : private util::noncopyable {
+public:
+    static SharedTileStore& get();
+
+    // Returns the tile that another Map loaded from this URL, or nullptr.
+    std::shared_ptr<const SharedVectorTile> find(const std::string& url);
+
+    void add(const std::string& url, std::shared_ptr<const SharedVectorTile>);
+
+    std::size_t size();
+
+private:
+    SharedTileStore() = default;
+
+    // Removes entries of tiles that no Map references anymore.
+    void prune();
+
+    std::mutex mtx;
+    std::unordered_map<std::string, std::weak_ptr<const SharedVectorTile>> tiles;
+    std::size_t pruneThreshold = 64;
+};
+
+}
+
+#endif
@@ -7,11 +7,13 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/json.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/box.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/style_layer.hpp>
+#include <mbgl/style/style_bucket.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/util/uv_detail.hpp>
 #include <mbgl/util/std.hpp>
@@ -92,6 +94,13 @@ void SourceInfo::parseTileJSONProperties(const rapidjson::Value& value) {
     parse(value, tiles, "tiles");
     parse(value, min_zoom, "minzoom");
     parse(value, max_zoom, "maxzoom");
+    // Tile keys have room for this many source zoom levels; deeper zoom levels are overscaled.
+    if (max_zoom > TileID::maxKeyZoom) {
+        max_zoom = TileID::maxKeyZoom;
+    }
+    if (min_zoom > max_zoom) {
+        min_zoom = max_zoom;
+    }
     parse(value, attribution, "attribution");
     parse(value, center, "center");
     parse(value, bounds, "bounds");
@@ -158,6 +167,11 @@ void Source::load() {
             return;
         }
 
+        if (util::jsonDepth(res.data) > util::maxJSONDepth) {
+            emitSourceLoadingFailed("Failed to parse [" + info.url + "]: nested too deeply");
+            return;
+        }
+
         rapidjson::Document d;
         d.Parse<0>(res.data.c_str());
 
@@ -186,6 +200,11 @@ void Source::updateMatrices(const mat4 &projMatrix, const TransformState &transf
 void Source::drawClippingMasks(Painter &painter) {
     for (const auto& pair : tiles) {
         Tile &tile = *pair.second;
+        if (tile.isFading()) {
+            // Fading tiles are drawn without stencil test on top of their placeholders,
+            // which must not be masked out.
+            continue;
+        }
         gl::debugging::group group(std::string { "mask: " } + std::string(tile.id));
         painter.drawClippingMask(tile.matrix, tile.clip);
     }
@@ -214,7 +233,7 @@ const std::vector<Tile*>& Source::getTiles() const {
 }
 
 TileData::State Source::hasTile(const TileID& id) {
-    auto it = tiles.find(id);
+    auto it = tiles.find(id.key());
     if (it != tiles.end()) {
         Tile& tile = *it->second;
         if (tile.id == id && tile.data) {
@@ -228,7 +247,7 @@ TileData::State Source::hasTile(const TileID& id) {
 bool Source::handlePartialTile(const TileID& id, Worker&) {
     const TileID normalized_id = id.normalized();
 
-    auto it = tile_data.find(normalized_id);
+    auto it = tile_data.find(normalized_id.key());
     if (it == tile_data.end()) {
         return true;
     }
@@ -262,7 +281,7 @@ TileData::State Source::addTile(MapData& data,
         return state;
     }
 
-    auto pos = tiles.emplace(id, std::make_unique<Tile>(id));
+    auto pos = tiles.emplace(id.key(), std::make_unique<Tile>(id));
 
     Tile& new_tile = *pos.first->second;
 
@@ -270,7 +289,7 @@ TileData::State Source::addTile(MapData& data,
     // Try to find the associated TileData object.
     const TileID normalized_id = id.normalized();
 
-    auto it = tile_data.find(normalized_id);
+    auto it = tile_data.find(normalized_id.key());
     if (it != tile_data.end()) {
         // Create a shared_ptr handle. Note that this might be empty!
         new_tile.data = it->second.lock();
@@ -282,7 +301,7 @@ TileData::State Source::addTile(MapData& data,
     }
 
     if (!new_tile.data) {
-        new_tile.data = cache.get(normalized_id.to_uint64());
+        new_tile.data = cache.get(normalized_id.key());
     }
 
     if (!new_tile.data) {
@@ -290,8 +309,13 @@ TileData::State Source::addTile(MapData& data,
 
         // If we don't find working tile data, we're just going to load it.
         if (info.type == SourceType::Vector) {
+            std::shared_ptr<VectorTileData> sourceTile;
+            if (normalized_id.z > normalized_id.sourceZ) {
+                sourceTile = getMaxZoomTileData(data, transformState, style, normalized_id);
+            }
             auto tileData = std::make_shared<VectorTileData>(normalized_id, style, info,
-                                                 transformState.getAngle(), data.getCollisionDebug());
+                                                 transformState.getAngle(), data.getCollisionDebug(),
+                                                 std::move(sourceTile));
             tileData->request(data.pixelRatio, callback);
             new_tile.data = tileData;
         } else if (info.type == SourceType::Raster) {
@@ -304,12 +328,39 @@ TileData::State Source::addTile(MapData& data,
         } else {
             throw std::runtime_error("source type not implemented");
         }
-        tile_data.emplace(new_tile.data->id, new_tile.data);
+        tile_data.emplace(new_tile.data->id.key(), new_tile.data);
     }
 
     return new_tile.data->getState();
 }
 
+std::shared_ptr<VectorTileData> Source::getMaxZoomTileData(MapData& data,
+                                                           const TransformState& transformState,
+                                                           Style& style,
+                                                           const TileID& overscaled_id) {
+    const TileID id { overscaled_id.sourceZ, overscaled_id.x, overscaled_id.y, overscaled_id.sourceZ };
+
+    std::shared_ptr<TileData> existing;
+    auto it = tile_data.find(id.key());
+    if (it != tile_data.end()) {
+        existing = it->second.lock();
+    }
+    if (!existing || existing->getState() == TileData::State::obsolete) {
+        existing = cache.get(id.key());
+    }
+
+    auto tileData = std::dynamic_pointer_cast<VectorTileData>(existing);
+    if (!tileData || tileData->getState() == TileData::State::obsolete) {
+        auto callback = std::bind(&Source::tileLoadingCompleteCallback, this, id, transformState, data.getCollisionDebug());
+        tileData = std::make_shared<VectorTileData>(id, style, info,
+                                                    transformState.getAngle(), data.getCollisionDebug());
+        tileData->request(data.pixelRatio, callback);
+    }
+
+    tile_data[id.key()] = tileData;
+    return tileData;
+}
+
 double Source::getZoom(const TransformState& state) const {
     double offset = std::log(util::tileSize / info.tile_size) / std::log(2);
     return state.getZoom() + offset;
@@ -325,7 +376,7 @@ int32_t Source::coveringZoomLevel(const TransformState& state) const {
     return zoom;
 }
 
-std::forward_list<TileID> Source::coveringTiles(const TransformState& state) const {
+const std::vector<TileID>& Source::coveringTiles(const TransformState& state, const TileLOD& lod) {
     int32_t z = coveringZoomLevel(state);
 
     auto actualZ = z;
@@ -333,22 +384,39 @@ std::forward_list<TileID> Source::coveringTiles(const TransformState& state) con
         info.type == SourceType::Vector ||
         info.type == SourceType::Annotations;
 
-    if (z < info.min_zoom) return {{}};
+    coveringIDs.clear();
+
+    if (z < info.min_zoom) return coveringIDs;
     if (z > info.max_zoom) z = info.max_zoom;
 
     // Map four viewport corners to pixel coordinates
     box points = state.cornersToBox(z);
-    const vec2<double>& center = points.center;
 
-    std::forward_list<TileID> covering_tiles = tileCover(z, points, reparseOverscaled ? actualZ : z);
+    // The cover is sorted by distance from the box center.
+    tileCover(z, points, cover);
 
-    covering_tiles.sort([&center](const TileID& a, const TileID& b) {
-        // Sorts by distance from the box center
-        return std::fabs(a.x - center.x) + std::fabs(a.y - center.y) <
-               std::fabs(b.x - center.x) + std::fabs(b.y - center.y);
-    });
+    const int8_t idZ = reparseOverscaled ? actualZ : z;
+
+    // Tiles too many worlds away from the first one have no key, so they can't be loaded.
+    cover.erase(std::remove_if(cover.begin(), cover.end(), [idZ, z](const CoveredTile& tile) {
+        return !TileID(idZ, tile.x, tile.y, z).hasKey();
+    }), cover.end());
+    if (!lod.isEnabled()) {
+        for (const auto& tile : cover) {
+            coveringIDs.emplace_back(idZ, tile.x, tile.y, z);
+        }
+        return coveringIDs;
+    }
+
+    // Tiles are never lowered below the source's minimum zoom level.
+    const int32_t maxDrop = std::min<int32_t>(lod.maxLevelDrop, idZ - info.min_zoom);
+    const double tileSize = state.worldSize() / (1 << z);
+    const double radius = lod.focusRadius > 0
+        ? lod.focusRadius
+        : std::sqrt(std::pow(state.getWidth(), 2) + std::pow(state.getHeight(), 2)) / 2;
 
-    return covering_tiles;
+    lodCover.build(cover, points.center, radius / tileSize, lod.tileBudget, maxDrop, z, idZ, coveringIDs);
+    return coveringIDs;
 }
 
 /**
@@ -360,21 +428,32 @@ std::forward_list<TileID> Source::coveringTiles(const TransformState& state) con
  *
  * @return boolean Whether the children found completely cover the tile.
  */
-bool Source::findLoadedChildren(const TileID& id, int32_t maxCoveringZoom, std::forward_list<TileID>& retain) {
+bool Source::findLoadedChildren(const TileID& id, int32_t maxCoveringZoom, TileKeySet& retain) {
     bool complete = true;
     int32_t z = id.z;
-    auto ids = id.children(info.max_zoom);
-    for (const auto& child_id : ids) {
-        const TileData::State state = hasTile(child_id);
-        if (TileData::isReadyState(state)) {
-            retain.emplace_front(child_id);
+    auto visit = [&](const TileID& child_id) {
+        if (pyramid.isReady(child_id)) {
+            retain.insert(child_id.key());
         } else {
             complete = false;
-            if (z < maxCoveringZoom) {
+            if (z < maxCoveringZoom && pyramid.hasReadyDescendants(child_id)) {
                 // Go further down the hierarchy to find more unloaded children.
                 findLoadedChildren(child_id, maxCoveringZoom, retain);
             }
         }
+    };
+
+    // Same as TileID::children(), without building a list for every visited tile.
+    const int8_t childZ = z + 1;
+    if (z >= info.max_zoom) {
+        visit(TileID{ childZ, id.x, id.y, static_cast<int8_t>(info.max_zoom) });
+    } else {
+        const int32_t childX = id.x * 2;
+        const int32_t childY = id.y * 2;
+        visit(TileID{ childZ, childX + 1, childY + 1, childZ });
+        visit(TileID{ childZ, childX, childY + 1, childZ });
+        visit(TileID{ childZ, childX + 1, childY, childZ });
+        visit(TileID{ childZ, childX, childY, childZ });
     }
     return complete;
 }
@@ -388,12 +467,11 @@ bool Source::findLoadedChildren(const TileID& id, int32_t maxCoveringZoom, std::
  *
  * @return boolean Whether a parent was found.
  */
-bool Source::findLoadedParent(const TileID& id, int32_t minCoveringZoom, std::forward_list<TileID>& retain) {
+bool Source::findLoadedParent(const TileID& id, int32_t minCoveringZoom, TileKeySet& retain) {
     for (int32_t z = id.z - 1; z >= minCoveringZoom; --z) {
         const TileID parent_id = id.parent(z, info.max_zoom);
-        const TileData::State state = hasTile(parent_id);
-        if (TileData::isReadyState(state)) {
-            retain.emplace_front(parent_id);
+        if (pyramid.isReady(parent_id)) {
+            retain.insert(parent_id.key());
             return true;
         }
     }
@@ -417,16 +495,33 @@ bool Source::update(MapData& data,
     } else {
         zoom = std::floor(zoom);
     }
-    std::forward_list<TileID> required = coveringTiles(transformState);
+    const std::vector<TileID>& required = coveringTiles(transformState, data.getTileLOD());
 
     // Determine the overzooming/underzooming amounts.
     int32_t minCoveringZoom = util::clamp<int32_t>(zoom - 10, info.min_zoom, info.max_zoom);
     int32_t maxCoveringZoom = util::clamp<int32_t>(zoom + 1,  info.min_zoom, info.max_zoom);
 
+    // Index the tiles that are ready, so that loaded parents and children of missing tiles
+    // can be found without walking every zoom level.
+    pyramid.clear();
+    for (const auto& pair : tiles) {
+        const Tile& tile = *pair.second;
+        if (tile.data && tile.data->isReady()) {
+            pyramid.add(tile.id, info.max_zoom);
+        }
+    }
+
+    const TimePoint now = data.getAnimationTime();
+    const Duration fadeDuration = getFadeDuration(data, style);
+
     // Retain is a list of tiles that we shouldn't delete, even if they are not
     // the most ideal tile for the current viewport. This may include tiles like
     // parent or child tiles that are *already* loaded.
-    std::forward_list<TileID> retain(required);
+    TileKeySet& retain = retainTiles;
+    retain.clear();
+    for (const auto& id : required) {
+        retain.insert(id.key());
+    }
 
     // Add existing child/parent tiles if the actual tile is not yet loaded
     for (const auto& id : required) {
@@ -442,6 +537,9 @@ bool Source::update(MapData& data,
             break;
         case TileData::State::invalid:
             state = addTile(data, transformState, style, texturePool, id);
+            if (TileData::isReadyState(state)) {
+                pyramid.add(id, info.max_zoom);
+            }
             break;
         default:
             break;
@@ -460,6 +558,12 @@ bool Source::update(MapData& data,
             if (!complete) {
                 findLoadedParent(id, minCoveringZoom, retain);
             }
+        } else if (fadeDuration > Duration::zero()) {
+            const auto it = tiles.find(id.key());
+            if (it != tiles.end() && updateFade(*it->second, now, fadeDuration)) {
+                // Keep the parent around while the tile fades in on top of it.
+                findLoadedParent(id, minCoveringZoom, retain);
+            }
         }
     }
 
@@ -476,43 +580,59 @@ bool Source::update(MapData& data,
 
     // Remove tiles that we definitely don't need, i.e. tiles that are not on
     // the required list.
-    std::set<TileID> retain_data;
-    util::erase_if(tiles, [&retain, &retain_data, &tileCache, &type](std::pair<const TileID, std::unique_ptr<Tile>> &pair) {
+    TileKeySet& retain_data = retainData;
+    retain_data.clear();
+    util::erase_if(tiles, [&retain, &retain_data, &tileCache, &type](std::pair<const uint64_t, std::unique_ptr<Tile>> &pair) {
         Tile &tile = *pair.second;
-        bool obsolete = std::find(retain.begin(), retain.end(), tile.id) == retain.end();
+        bool obsolete = !retain.has(tile.id.key());
         if (!obsolete) {
-            retain_data.insert(tile.data->id);
+            const TileID& dataID = tile.data->id;
+            retain_data.insert(dataID.key());
+            if (dataID.z > dataID.sourceZ) {
+                // Overscaled tiles are parsed from the data of their tile at the source's
+                // maximum zoom level, so that one needs to stay around as well.
+                retain_data.insert(TileID(dataID.sourceZ, dataID.x, dataID.y, dataID.sourceZ).key());
+            }
         } else if (type != SourceType::Raster && tile.data->getState() == TileData::State::parsed) {
             // Partially parsed tiles are never added to the cache because otherwise
             // they never get updated if the go out from the viewport and the pending
             // resources arrive.
-            tileCache.add(tile.id.normalized().to_uint64(), tile.data);
+            tileCache.add(tile.id.normalized().key(), tile.data);
         }
         return obsolete;
     });
 
     // Remove all the expired pointers from the set.
-    util::erase_if(tile_data, [&retain_data, &tileCache](std::pair<const TileID, std::weak_ptr<TileData>> &pair) {
+    util::erase_if(tile_data, [&retain_data, &tileCache](std::pair<const uint64_t, std::weak_ptr<TileData>> &pair) {
         const util::ptr<TileData> tile = pair.second.lock();
         if (!tile) {
             return true;
         }
 
-        bool obsolete = retain_data.find(tile->id) == retain_data.end();
-        if (obsolete) {
-            if (!tileCache.has(tile->id.normalized().to_uint64())) {
-                tile->cancel();
-            }
+        bool obsolete = !retain_data.has(tile->id.key());
+        if (!obsolete) {
+            return false;
+        } else if (tileCache.has(tile->id.normalized().key())) {
+            return true;
+        } else if (tile.use_count() == 1) {
+            tile->cancel();
             return true;
         } else {
+            // Data that is still referenced elsewhere, e.g. the source tile of cached overscaled
+            // tiles, keeps loading. It stays indexed so that addTile() and getMaxZoomTileData()
+            // reuse it instead of requesting it again, until the last reference goes away.
             return false;
         }
     });
 
     updateTilePtrs();
 
+    fading = false;
     for (auto& tilePtr : tilePtrs) {
         tilePtr->data->redoPlacement(transformState.getAngle(), data.getCollisionDebug());
+        if (updateFade(*tilePtr, now, fadeDuration)) {
+            fading = true;
+        }
     }
 
     updated = data.getAnimationTime();
@@ -520,12 +640,51 @@ bool Source::update(MapData& data,
     return allTilesUpdated;
 }
 
+Duration Source::getFadeDuration(const MapData& data, const Style& style) const {
+    // Only raster layers can draw a tile with an opacity of its own; vector tiles replace
+    // their placeholders instantly.
+    if (info.type != SourceType::Raster || data.mode == MapMode::Still) {
+        return Duration::zero();
+    }
+
+    float fade = 0;
+    for (const auto& layer : style.layers) {
+        if (layer->type == StyleLayerType::Raster && layer->bucket &&
+            layer->bucket->source == info.source_id) {
+            fade = std::max(fade, layer->getProperties<RasterProperties>().fade);
+        }
+    }
+
+    return std::chrono::duration_cast<Duration>(std::chrono::duration<float, std::milli>(fade));
+}
+
+bool Source::updateFade(Tile& tile, TimePoint now, Duration fadeDuration) {
+    if (!tile.data || !tile.data->isReady()) {
+        tile.opacity = 1;
+        return false;
+    }
+
+    if (tile.readyTime == TimePoint::max()) {
+        tile.readyTime = now;
+    }
+
+    if (fadeDuration <= Duration::zero()) {
+        tile.opacity = 1;
+    } else {
+        const float t = std::chrono::duration<float>(now - tile.readyTime) /
+                        std::chrono::duration<float>(fadeDuration);
+        tile.opacity = util::clamp(t, 0.0f, 1.0f);
+    }
+
+    return tile.isFading();
+}
+
 void Source::invalidateTiles(const std::unordered_set<TileID, TileID::Hash>& ids) {
     cache.clear();
     if (ids.size()) {
         for (auto& id : ids) {
-            tiles.erase(id);
-            tile_data.erase(id);
+            tiles.erase(id.key());
+            tile_data.erase(id.key());
         }
     } else {
         tiles.clear();
@@ -549,12 +708,24 @@ void Source::onLowMemory() {
     cache.clear();
 }
 
+void Source::addMemoryUsage(MemoryUsage& usage) const {
+    for (const auto& pair : tile_data) {
+        if (const auto tileData = pair.second.lock()) {
+            usage.categories[MemoryUsage::Tiles] += tileData->getMemoryFootprint();
+            usage.tiles++;
+        }
+    }
+
+    usage.categories[MemoryUsage::TileCache] += cache.getMemoryFootprint();
+    usage.cachedTiles += cache.count();
+}
+
 void Source::setObserver(Observer* observer) {
     observer_ = observer;
 }
 
 void Source::tileLoadingCompleteCallback(const TileID& normalized_id, const TransformState& transformState, bool collisionDebug) {
-    auto it = tile_data.find(normalized_id);
+    auto it = tile_data.find(normalized_id.key());
     if (it == tile_data.end()) {
         return;
     }
@@ -4,7 +4,11 @@
 #include <mbgl/map/tile_id.hpp>
 #include <mbgl/map/tile_data.hpp>
 #include <mbgl/map/tile_cache.hpp>
+#include <mbgl/map/tile_key_set.hpp>
+#include <mbgl/map/tile_pyramid.hpp>
 #include <mbgl/style/types.hpp>
+#include <mbgl/map/tile_lod.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -28,6 +32,7 @@ class Painter;
 class Request;
 class TransformState;
 class Tile;
+class VectorTileData;
 struct ClipID;
 struct box;
 
@@ -89,8 +94,14 @@ public:
     void setCacheSize(size_t);
     void onLowMemory();
 
+    // Adds the tiles of this source to the Tiles and TileCache categories.
+    void addMemoryUsage(MemoryUsage&) const;
+
     void setObserver(Observer* observer);
 
+    // Whether any tile is still fading in over its placeholder.
+    bool isFading() const { return fading; }
+
     SourceInfo info;
     bool enabled;
 
@@ -103,10 +114,10 @@ private:
     void emitTileLoadingFailed(const std::string& message);
 
     bool handlePartialTile(const TileID &id, Worker &worker);
-    bool findLoadedChildren(const TileID& id, int32_t maxCoveringZoom, std::forward_list<TileID>& retain);
-    bool findLoadedParent(const TileID& id, int32_t minCoveringZoom, std::forward_list<TileID>& retain);
+    bool findLoadedChildren(const TileID& id, int32_t maxCoveringZoom, TileKeySet& retain);
+    bool findLoadedParent(const TileID& id, int32_t minCoveringZoom, TileKeySet& retain);
     int32_t coveringZoomLevel(const TransformState&) const;
-    std::forward_list<TileID> coveringTiles(const TransformState&) const;
+    const std::vector<TileID>& coveringTiles(const TransformState&, const TileLOD&);
 
     TileData::State addTile(MapData&,
                             const TransformState&,
@@ -114,21 +125,45 @@ private:
                             TexturePool&,
                             const TileID&);
 
+    std::shared_ptr<VectorTileData> getMaxZoomTileData(MapData&,
+                                                       const TransformState&,
+                                                       Style&,
+                                                       const TileID& overscaled_id);
+
     TileData::State hasTile(const TileID& id);
     void updateTilePtrs();
 
     double getZoom(const TransformState &state) const;
 
+    Duration getFadeDuration(const MapData&, const Style&) const;
+
+    // Updates the opacity of a tile that fades in after its data became ready. Returns
+    // whether the tile is still fading.
+    bool updateFade(Tile&, TimePoint now, Duration fadeDuration);
+
     bool loaded = false;
 
     // Stores the time when this source was most recently updated.
     TimePoint updated = TimePoint::min();
 
-    std::map<TileID, std::unique_ptr<Tile>> tiles;
+    // Both maps are keyed by TileID::key(), so they are sorted by wrap, zoom level and source
+    // zoom level, and then in Morton order.
+    std::map<uint64_t, std::unique_ptr<Tile>> tiles;
     std::vector<Tile*> tilePtrs;
-    std::map<TileID, std::weak_ptr<TileData>> tile_data;
+    std::map<uint64_t, std::weak_ptr<TileData>> tile_data;
     TileCache cache;
 
+    // Scratch containers for update(). They are members so that their storage is reused
+    // between frames instead of being allocated on every update.
+    std::vector<CoveredTile> cover;
+    std::vector<TileID> coveringIDs;
+    LODCover lodCover;
+    TileKeySet retainTiles;
+    TileKeySet retainData;
+    TilePyramid pyramid;
+
+    bool fading = false;
+
     Request* req = nullptr;
     Observer* observer_ = nullptr;
 };
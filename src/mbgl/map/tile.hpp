@@ -5,6 +5,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/util/clip_id.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/map/tile_id.hpp>
 
 namespace mbgl {
@@ -17,10 +18,19 @@ public:
     explicit Tile(const TileID& id_)
         : id(id_) {}
 
+    // Tiles of sources with a fade duration fade in once their data is ready. While they
+    // do, they are drawn on top of their placeholder instead of clipping it.
+    inline bool isFading() const {
+        return opacity < 1;
+    }
+
     const TileID id;
     ClipID clip;
     mat4 matrix;
     util::ptr<TileData> data;
+
+    TimePoint readyTime = TimePoint::max();
+    float opacity = 1;
 };
 
 }
@@ -1,16 +1,31 @@
 #include <mbgl/map/tile_cache.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 
 #include <cassert>
 
 namespace mbgl {
 
+namespace {
+
+metrics::Counter hits("tile_cache.hits");
+metrics::Counter misses("tile_cache.misses");
+metrics::Counter evictions("tile_cache.evictions");
+metrics::Gauge cachedTiles("tile_cache.tiles");
+
+}
+
+TileCache::~TileCache() {
+    cachedTiles.subtract(tiles.size());
+}
+
 void TileCache::setSize(size_t size_) {
     size = size_;
 
     while (orderedKeys.size() > size) {
         auto key = orderedKeys.front();
         orderedKeys.pop_front();
-        tiles.erase(key);
+        cachedTiles.subtract(tiles.erase(key));
+        evictions.add();
     }
 
     assert(orderedKeys.size() <= size);
@@ -24,6 +39,7 @@ void TileCache::add(uint64_t key, std::shared_ptr<TileData> data) {
     if (tiles.emplace(key, data).second) {
         // remove existing data key
         orderedKeys.remove(key);
+        cachedTiles.add(1);
     }
 
     // (re-)insert data key as newest
@@ -31,7 +47,10 @@ void TileCache::add(uint64_t key, std::shared_ptr<TileData> data) {
 
     // purge oldest key/data if necessary
     if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+        const auto oldest = orderedKeys.front();
+        cachedTiles.subtract(tiles.erase(oldest));
+        orderedKeys.remove(oldest);
+        evictions.add();
     }
 
     assert(orderedKeys.size() <= size);
@@ -46,7 +65,11 @@ std::shared_ptr<TileData> TileCache::get(uint64_t key) {
         data = it->second;
         tiles.erase(it);
         orderedKeys.remove(key);
+        cachedTiles.subtract(1);
         assert(data->isReady());
+        hits.add();
+    } else {
+        misses.add();
     }
 
     return data;
@@ -56,7 +79,16 @@ bool TileCache::has(uint64_t key) {
     return tiles.find(key) != tiles.end();
 }
 
+MemoryFootprint TileCache::getMemoryFootprint() const {
+    MemoryFootprint footprint;
+    for (const auto& tile : tiles) {
+        footprint += tile.second->getMemoryFootprint();
+    }
+    return footprint;
+}
+
 void TileCache::clear() {
+    cachedTiles.subtract(tiles.size());
     orderedKeys.clear();
     tiles.clear();
 }
@@ -11,6 +11,7 @@ namespace mbgl {
 class TileCache {
 public:
     TileCache(size_t size_ = 0) : size(size_) {}
+    ~TileCache();
 
     void setSize(size_t);
     size_t getSize() const { return size; };
@@ -18,6 +19,9 @@ public:
     std::shared_ptr<TileData> get(uint64_t key);
     bool has(uint64_t key);
     void clear();
+
+    std::size_t count() const { return tiles.size(); }
+    MemoryFootprint getMemoryFootprint() const;
 private:
     std::unordered_map<uint64_t, std::shared_ptr<TileData>> tiles;
     std::list<uint64_t> orderedKeys;
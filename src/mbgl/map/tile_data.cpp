@@ -2,10 +2,25 @@
 
 using namespace mbgl;
 
+namespace {
+
+std::atomic<uint64_t> nextRevision { 1 };
+
+}
+
 TileData::TileData(const TileID& id_)
     : id(id_),
       debugBucket(debugFontBuffer),
-      state(State::initial) {
+      state(State::initial),
+      revision(nextRevision++) {
     // Initialize tile debug coordinates
     debugFontBuffer.addText(std::string(id).c_str(), 50, 200, 5);
 }
+
+void TileData::updateRevision() {
+    revision = nextRevision++;
+}
+
+MemoryFootprint TileData::getMemoryFootprint() const {
+    return debugFontBuffer.getMemoryFootprint();
+}
@@ -3,6 +3,7 @@
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/map/tile_id.hpp>
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/renderer/debug_bucket.hpp>
 #include <mbgl/geometry/debug_font_buffer.hpp>
 
@@ -74,6 +75,10 @@ public:
 
     virtual void redoPlacement(float, bool) {}
 
+    // Memory held by the tile and its buckets. Buckets of tiles that aren't ready yet are
+    // still being built on a worker thread, so they aren't counted.
+    virtual MemoryFootprint getMemoryFootprint() const;
+
     bool isReady() const {
         return isReadyState(state);
     }
@@ -82,6 +87,12 @@ public:
         return state;
     }
 
+    // Changes whenever the buckets that render the tile change. Revisions are unique across all
+    // tiles, so a cache of rendered tiles never mistakes one version of a tile for another.
+    virtual uint64_t getRevision() const {
+        return revision;
+    }
+
     std::string getError() const {
         return error;
     }
@@ -93,7 +104,11 @@ public:
     DebugFontBuffer debugFontBuffer;
 
 protected:
+    // Called when a parse produced new buckets.
+    void updateRevision();
+
     std::atomic<State> state;
+    std::atomic<uint64_t> revision;
     std::string error;
 };
 
@@ -43,7 +43,7 @@ std::forward_list<TileID> TileID::children(int8_t sourceMaxZoom) const {
 }
 
 TileID TileID::normalized() const {
-    int32_t dim = std::pow(2, sourceZ);
+    const int32_t dim = 1 << sourceZ;
     int32_t nx = x, ny = y;
     while (nx < 0) nx += dim;
     while (nx >= dim) nx -= dim;
@@ -54,7 +54,7 @@ bool TileID::isChildOf(const TileID &parent_id) const {
     if (parent_id.z >= z || parent_id.w != w) {
         return false;
     }
-    int32_t scale = std::pow(2, z - parent_id.z);
+    const int32_t scale = 1 << (z - parent_id.z);
     return parent_id.x == ((x < 0 ? x - scale + 1 : x) / scale) &&
            parent_id.y == y / scale;
 }
@@ -1,11 +1,15 @@
 #ifndef MBGL_MAP_TILE_ID
 #define MBGL_MAP_TILE_ID
 
+#include <mbgl/util/space_filling_curve.hpp>
+
+#include <cassert>
 #include <cstdint>
 #include <cmath>
 #include <string>
 #include <functional>
 #include <forward_list>
+#include <utility>
 
 namespace mbgl {
 
@@ -21,13 +25,71 @@ public:
         : w((x_ < 0 ? x_ - (1 << z_) + 1 : x_) / (1 << z_)), z(z_), x(x_), y(y_),
         sourceZ(sourceZ_), overscaling(std::pow(2, z_ - sourceZ_)) {}
 
-    inline uint64_t to_uint64() const {
-        return ((std::pow(2, z) * y + x) * 32) + z;
+    // The range of tiles that key() can pack.
+    static const int8_t maxKeyZoom = 23;
+    static const int32_t minKeyWrap = -128;
+    static const int32_t maxKeyWrap = 127;
+
+    // Whether key() is unique for this tile. Tiles outside of this range must not be created
+    // by code that indexes tiles by their key.
+    inline bool hasKey() const {
+        if (z < 0 || z > 31 || sourceZ < 0 || sourceZ > maxKeyZoom) {
+            return false;
+        }
+        const int32_t wrap = x >> sourceZ;
+        return wrap >= minKeyWrap && wrap <= maxKeyWrap;
+    }
+
+    // Packs the tile into a 64-bit integer: 8 bits of wrap (offset by 128), 5 bits of z, 5 bits
+    // of sourceZ and the Morton index of the wrapped x and y in the remaining 46 bits. The key
+    // is unique for every tile for which hasKey() is true. Keys sort by wrap, z and sourceZ
+    // first, so all descendants of a tile at one zoom level form a contiguous range; see
+    // keyRange().
+    inline uint64_t key() const {
+        assert(hasKey());
+        const int32_t wrap = x >> sourceZ;
+        const uint32_t wrappedX = uint32_t(x - wrap * (1 << sourceZ));
+        return (uint64_t(uint8_t(wrap + 128)) << 56) |
+               (uint64_t(z) << 51) |
+               (uint64_t(sourceZ) << 46) |
+               util::mortonEncode(wrappedX, uint32_t(y));
+    }
+
+    static inline TileID fromKey(uint64_t key) {
+        const int32_t wrap = int32_t(key >> 56) - 128;
+        const int8_t z_ = (key >> 51) & 0x1F;
+        const int8_t sourceZ_ = (key >> 46) & 0x1F;
+        const auto xy = util::mortonDecode(key & ((uint64_t(1) << 46) - 1));
+        return TileID{ z_, int32_t(xy.first) + wrap * (1 << sourceZ_), int32_t(xy.second), sourceZ_ };
+    }
+
+    // Returns the [first, last) range of keys that contains the keys of all tiles at zoom
+    // level z_ (with source zoom level sourceZ_) that are covered by this tile.
+    inline std::pair<uint64_t, uint64_t> keyRange(int8_t z_, int8_t sourceZ_) const {
+        assert(sourceZ_ >= sourceZ);
+        const uint64_t own = key();
+        const uint64_t level = (own & ~((uint64_t(1) << 56) - 1)) |
+                               (uint64_t(z_) << 51) | (uint64_t(sourceZ_) << 46);
+        const int shift = 2 * (sourceZ_ - sourceZ);
+        const uint64_t morton = own & ((uint64_t(1) << 46) - 1);
+        return { level + (morton << shift), level + ((morton + 1) << shift) };
+    }
+
+    // Finalizer of MurmurHash3. Keys of neighbouring tiles only differ in their low bits, so
+    // they are mixed before being used as a hash.
+    static inline std::size_t hashKey(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return std::size_t(h);
     }
 
+    // Hashes the fields that operator== compares; w follows from z and x.
     struct Hash {
         std::size_t operator()(const TileID& id) const {
-            return std::hash<uint64_t>()(id.to_uint64());
+            return hashKey((uint64_t(uint32_t(id.x)) << 32 | uint32_t(id.y)) ^ (uint64_t(id.z) << 58));
         }
     };
 
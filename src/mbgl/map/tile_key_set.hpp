@@ -0,0 +1,86 @@
+#ifndef MBGL_MAP_TILE_KEY_SET
+#define MBGL_MAP_TILE_KEY_SET
+
+#include <mbgl/map/tile_id.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace mbgl {
+
+// Open addressing hash set of packed 64-bit tile keys (see TileID::key()). Clearing the set keeps its storage,
+// so a set that is refilled every frame only allocates when it has to grow beyond the
+// largest number of keys it held so far.
+class TileKeySet : private util::noncopyable {
+public:
+    TileKeySet() = default;
+
+    inline void clear() {
+        if (count) {
+            std::fill(slots.begin(), slots.end(), uint64_t(unused));
+            count = 0;
+        }
+    }
+
+    inline void reserve(std::size_t n) {
+        std::size_t capacity = 16;
+        while (capacity < n * 2) capacity <<= 1;
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    // Returns true if the key was not yet part of the set.
+    inline bool insert(uint64_t key) {
+        if ((count + 1) * 2 > slots.size()) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        std::size_t i = probe(key);
+        if (slots[i] == key) {
+            return false;
+        }
+        slots[i] = key;
+        count++;
+        return true;
+    }
+
+    inline bool has(uint64_t key) const {
+        return count && slots[probe(key)] == key;
+    }
+
+    inline std::size_t size() const { return count; }
+    inline bool empty() const { return count == 0; }
+
+private:
+    // Tile keys never have all bits set, so this value marks unused slots.
+    static constexpr uint64_t unused = ~uint64_t(0);
+
+    // Returns the slot that holds the key, or the empty slot where it would be inserted.
+    inline std::size_t probe(uint64_t key) const {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t i = TileID::hashKey(key) & mask;
+        while (slots[i] != unused && slots[i] != key) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    inline void rehash(std::size_t capacity) {
+        std::vector<uint64_t> old(capacity, uint64_t(unused));
+        old.swap(slots);
+        for (const uint64_t key : old) {
+            if (key != unused) {
+                slots[probe(key)] = key;
+            }
+        }
+    }
+
+    std::vector<uint64_t> slots;
+    std::size_t count = 0;
+};
+
+}
+
+#endif
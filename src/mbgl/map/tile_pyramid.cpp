@@ -0,0 +1,27 @@
+#include <mbgl/map/tile_pyramid.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+void TilePyramid::add(const TileID& id, int32_t sourceMaxZoom) {
+    ready.insert(id.key());
+
+    int32_t x = id.x;
+    int32_t y = id.y;
+    for (int32_t z = id.z; z > 0; z--) {
+        if (z <= sourceMaxZoom) {
+            x /= 2;
+            y /= 2;
+        }
+
+        const int8_t parentZ = z - 1;
+        const TileID parent { parentZ, x, y, int8_t(std::min<int32_t>(parentZ, sourceMaxZoom)) };
+        if (!ancestors.insert(parent.key())) {
+            // This ancestor and all of its ancestors were recorded by another tile already.
+            break;
+        }
+    }
+}
+
+}
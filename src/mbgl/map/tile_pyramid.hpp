@@ -0,0 +1,40 @@
+#ifndef MBGL_MAP_TILE_PYRAMID
+#define MBGL_MAP_TILE_PYRAMID
+
+#include <mbgl/map/tile_id.hpp>
+#include <mbgl/map/tile_key_set.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+namespace mbgl {
+
+// Quadtree over the tiles of a source that are ready for rendering. Besides the ready tiles,
+// it records every ancestor of a ready tile, so that the search for a loaded ancestor costs
+// one lookup per zoom level, and the search for loaded descendants only descends into
+// branches that actually contain one.
+class TilePyramid : private util::noncopyable {
+public:
+    inline void clear() {
+        ready.clear();
+        ancestors.clear();
+    }
+
+    // Adds a ready tile. Ancestors are computed the same way as TileID::parent(), so that
+    // overscaled tiles above sourceMaxZoom keep their coordinates.
+    void add(const TileID&, int32_t sourceMaxZoom);
+
+    inline bool isReady(const TileID& id) const {
+        return ready.has(id.key());
+    }
+
+    inline bool hasReadyDescendants(const TileID& id) const {
+        return ancestors.has(id.key());
+    }
+
+private:
+    TileKeySet ready;
+    TileKeySet ancestors;
+};
+
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/map/tile_worker.hpp>
+#include <mbgl/map/bucket_cache.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/geometry/glyph_atlas.hpp>
@@ -7,7 +8,9 @@
 #include <mbgl/renderer/line_bucket.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
 #include <mbgl/platform/log.hpp>
+#include <mbgl/util/allocation_stats.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/trace.hpp>
 
 using namespace mbgl;
 
@@ -49,25 +52,75 @@ size_t TileWorker::countBuckets() const {
     return buckets.size();
 }
 
-TileParseResult TileWorker::parse(const GeometryTile& geometryTile) {
+MemoryFootprint TileWorker::getMemoryFootprint() const {
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+    MemoryFootprint footprint;
+    for (const auto& bucket : buckets) {
+        footprint += bucket.second->getMemoryFootprint();
+    }
+    return footprint;
+}
+
+TileParseResult TileWorker::parse(const GeometryTile& geometryTile, std::size_t dataHash) {
+    MBGL_TRACE_SCOPE("tile", "parse");
     partialParse = false;
 
-    for (const auto& layer : layers) {
-        parseLayer(*layer, geometryTile);
+    allocation::Counters allocations;
+    {
+        const allocation::CountScope count(allocations);
+        const allocation::TagScope tag(allocation::Parse);
+
+        // Fill and line buckets are complete after the first parse. Later parses only add symbol
+        // buckets, and may run after the buffers were uploaded.
+        const bool useBucketCache = bucketCache && dataHash && firstParse;
+        firstParse = false;
+
+        BucketCache::Buffers buffers { fillVertexBuffer, lineVertexBuffer, triangleElementsBuffer, lineElementsBuffer };
+        bool cached = false;
+        if (useBucketCache) {
+            std::lock_guard<std::mutex> lock(bucketsMutex);
+            cached = bucketCache->load(sourceID, id, dataHash, buffers, buckets);
+        }
+
+        // Layers whose buckets were restored are skipped.
+        for (const auto& layer : layers) {
+            parseLayer(*layer, geometryTile);
+        }
+
+        // Only this thread modifies the buckets, so reading them needs no lock.
+        if (useBucketCache && !cached && state != TileData::State::obsolete) {
+            bucketCache->save(sourceID, id, dataHash, buffers, buckets);
+        }
+    }
+
+    if (allocation::enabled) {
+        Log::Debug(Event::ParseTile, "allocations parsing tile %d/%d/%d: %s",
+                   id.z, id.x, id.y, allocation::toString(allocations).c_str());
     }
 
     return partialParse ? TileData::State::partial : TileData::State::parsed;
 }
 
 void TileWorker::redoPlacement(float angle, bool collisionDebug) {
-    collision->reset(angle, 0);
-    collision->setDebug(collisionDebug);
-    for (const auto& layer_desc : layers) {
-        auto bucket = getBucket(*layer_desc);
-        if (bucket) {
-            bucket->placeFeatures();
+    MBGL_TRACE_SCOPE("tile", "placement");
+    allocation::Counters allocations;
+    {
+        const allocation::CountScope count(allocations);
+
+        collision->reset(angle, 0);
+        collision->setDebug(collisionDebug);
+        for (const auto& layer_desc : layers) {
+            auto bucket = getBucket(*layer_desc);
+            if (bucket) {
+                bucket->placeFeatures();
+            }
         }
     }
+
+    if (allocation::enabled) {
+        Log::Debug(Event::ParseTile, "allocations placing tile %d/%d/%d: %s",
+                   id.z, id.x, id.y, allocation::toString(allocations).c_str());
+    }
 }
 
 template <typename T>
@@ -131,6 +184,8 @@ void TileWorker::parseLayer(const StyleLayer& layer, const GeometryTile& geometr
         return;
     if (styleBucket.visibility == mbgl::VisibilityType::None)
         return;
+    if (borrowFillBuckets && styleBucket.type == StyleLayerType::Fill)
+        return;
 
     auto geometryLayer = geometryTile.getLayer(styleBucket.source_layer);
     if (!geometryLayer) {
@@ -184,6 +239,7 @@ void TileWorker::addBucketGeometries(Bucket& bucket, const GeometryTileLayer& la
 
 std::unique_ptr<Bucket> TileWorker::createFillBucket(const GeometryTileLayer& layer,
                                                      const StyleBucket& bucket_desc) {
+    MBGL_TRACE_SCOPE("tile", "fill bucket");
     auto bucket = std::make_unique<FillBucket>(fillVertexBuffer,
                                                 triangleElementsBuffer,
                                                 lineElementsBuffer);
@@ -193,6 +249,7 @@ std::unique_ptr<Bucket> TileWorker::createFillBucket(const GeometryTileLayer& la
 
 std::unique_ptr<Bucket> TileWorker::createLineBucket(const GeometryTileLayer& layer,
                                                      const StyleBucket& bucket_desc) {
+    MBGL_TRACE_SCOPE("tile", "line bucket");
     auto bucket = std::make_unique<LineBucket>(lineVertexBuffer,
                                                 triangleElementsBuffer);
 
@@ -210,6 +267,7 @@ std::unique_ptr<Bucket> TileWorker::createLineBucket(const GeometryTileLayer& la
 
 std::unique_ptr<Bucket> TileWorker::createSymbolBucket(const GeometryTileLayer& layer,
                                                        const StyleBucket& bucket_desc) {
+    MBGL_TRACE_SCOPE("tile", "symbol bucket");
     auto bucket = std::make_unique<SymbolBucket>(*collision, id.overscaling);
 
     const float z = id.z;
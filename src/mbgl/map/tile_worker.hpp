@@ -17,6 +17,7 @@
 
 namespace mbgl {
 
+class BucketCache;
 class CollisionTile;
 class GeometryTile;
 class Style;
@@ -42,12 +43,24 @@ public:
 
     Bucket* getBucket(const StyleLayer&) const;
     size_t countBuckets() const;
+    MemoryFootprint getMemoryFootprint() const;
 
-    TileParseResult parse(const GeometryTile&);
+    // dataHash identifies the raw data of the tile in the bucket cache. Tiles without raw data
+    // pass zero, which disables the cache.
+    TileParseResult parse(const GeometryTile&, std::size_t dataHash = 0);
     void redoPlacement(float angle, bool collisionDebug);
 
     std::vector<util::ptr<StyleLayer>> layers;
 
+    // Set for overscaled tiles. Fill geometry does not depend on the zoom level, so these
+    // tiles render the fill buckets of the tile at the source's maximum zoom level instead
+    // of creating their own.
+    bool borrowFillBuckets = false;
+
+    // When set, the first parse restores the fill and line buckets from this cache, or writes
+    // them to it.
+    std::unique_ptr<BucketCache> bucketCache;
+
 private:
     void parseLayer(const StyleLayer&, const GeometryTile&);
 
@@ -66,6 +79,7 @@ private:
     const std::atomic<TileData::State>& state;
 
     bool partialParse = false;
+    bool firstParse = true;
 
     FillVertexBuffer fillVertexBuffer;
     LineVertexBuffer lineVertexBuffer;
@@ -1,7 +1,16 @@
 #include <mbgl/map/vector_tile.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
+namespace {
+
+// A node of a std::map holds three pointers and the color next to the value.
+const std::size_t mapNodeOverhead = 4 * sizeof(void*);
+
+}
+
 Value parseValue(pbf data) {
     while (data.next())
     {
@@ -52,6 +61,8 @@ mapbox::util::optional<Value> VectorTileFeature::getValue(const std::string& key
         return mapbox::util::optional<Value>();
     }
 
+    // Features usually have a few tags, and the one asked for is often among the first, so
+    // decoding them one at a time until it is found is faster than decoding all of them.
     pbf tags = tags_pbf;
     while (tags) {
         uint32_t tag_key = tags.varint();
@@ -78,9 +89,20 @@ mapbox::util::optional<Value> VectorTileFeature::getValue(const std::string& key
 }
 
 GeometryCollection VectorTileFeature::getGeometries() const {
+    // The command stream is decoded in batches into a buffer on the stack, so that decoding
+    // doesn't allocate.
     pbf data(geometry_pbf);
-    uint8_t cmd = 1;
-    uint32_t length = 0;
+    uint32_t values[256];
+    std::size_t count = 0;
+    std::size_t i = 0;
+    const auto more = [&] {
+        if (i == count && data.data < data.end) {
+            count = data.packedVarints(values, sizeof(values) / sizeof(values[0]));
+            i = 0;
+        }
+        return i < count;
+    };
+
     int32_t x = 0;
     int32_t y = 0;
 
@@ -89,28 +111,32 @@ GeometryCollection VectorTileFeature::getGeometries() const {
     lines.emplace_back();
     std::vector<Coordinate>* line = &lines.back();
 
-    while (data.data < data.end) {
-        if (length == 0) {
-            uint32_t cmd_length = data.varint();
-            cmd = cmd_length & 0x7;
-            length = cmd_length >> 3;
-        }
-
-        --length;
+    while (more()) {
+        const uint32_t cmd_length = values[i++];
+        const uint8_t cmd = cmd_length & 0x7;
+        const uint32_t length = cmd_length >> 3;
 
         if (cmd == 1 || cmd == 2) {
-            x += data.svarint();
-            y += data.svarint();
-
-            if (cmd == 1 && !line->empty()) { // moveTo
-                lines.emplace_back();
-                line = &lines.back();
+            for (uint32_t j = 0; j < length && more(); j++) {
+                const uint32_t dx = values[i++];
+                if (!more()) {
+                    throw pbf::unterminated_varint_exception();
+                }
+                x += pbf::zigzag(dx);
+                y += pbf::zigzag(values[i++]);
+
+                if (cmd == 1 && !line->empty()) { // moveTo
+                    lines.emplace_back();
+                    line = &lines.back();
+                }
+
+                line->emplace_back(x, y);
             }
 
-            line->emplace_back(x, y);
-
         } else if (cmd == 7) { // closePolygon
-            if (!line->empty()) {
+            // The count is always 1. Closing a ring more than once would only add copies of
+            // the first point, as many as the count, which can be up to 2^29.
+            if (length > 0 && !line->empty()) {
                 line->push_back((*line)[0]);
             }
 
@@ -141,6 +167,15 @@ util::ptr<GeometryTileLayer> VectorTile::getLayer(const std::string& name) const
     return nullptr;
 }
 
+std::size_t VectorTile::getMemorySize() const {
+    std::size_t size = sizeof(*this);
+    for (const auto& layer : layers) {
+        size += mapNodeOverhead + sizeof(layer) + layer.first.capacity();
+        size += static_cast<const VectorTileLayer&>(*layer.second).getMemorySize();
+    }
+    return size;
+}
+
 VectorTileLayer::VectorTileLayer(pbf layer_pbf) {
     while (layer_pbf.next()) {
         if (layer_pbf.tag == 1) { // name
@@ -163,4 +198,50 @@ util::ptr<const GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i)
     return std::make_shared<VectorTileFeature>(features.at(i), *this);
 }
 
+std::size_t VectorTileLayer::getMemorySize() const {
+    std::size_t size = sizeof(*this) + name.capacity();
+    for (const auto& key : keys) {
+        size += mapNodeOverhead + sizeof(key) + key.first.capacity();
+    }
+    size += values.capacity() * sizeof(Value);
+    for (const auto& value : values) {
+        if (value.is<std::string>()) {
+            size += value.get<std::string>().capacity();
+        }
+    }
+    size += features.capacity() * sizeof(pbf);
+    return size;
+}
+
+SharedVectorTile::SharedVectorTile(std::string data_)
+    : data(std::move(data_)),
+      dataHash(std::max<std::size_t>(1, std::hash<std::string>()(data))) {
+}
+
+std::shared_ptr<const VectorTile> SharedVectorTile::get() const {
+    // Holding the lock while decoding makes concurrent callers wait for the one decode.
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!tile) {
+        pbf tilePBF(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+        tile = std::make_shared<const VectorTile>(tilePBF);
+    }
+    return tile;
+}
+
+void SharedVectorTile::release() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    tile.reset();
+}
+
+std::size_t SharedVectorTile::getMemoryShare() const {
+    std::size_t size = data.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tile) {
+            size += tile->getMemorySize();
+        }
+    }
+    return size / std::max<uint32_t>(1, holders);
+}
+
 }
@@ -4,7 +4,10 @@
 #include <mbgl/map/geometry_tile.hpp>
 #include <mbgl/util/pbf.hpp>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace mbgl {
 
@@ -33,6 +36,9 @@ public:
     std::size_t featureCount() const override { return features.size(); }
     util::ptr<const GeometryTileFeature> getFeature(std::size_t) const override;
 
+    // Estimated from the element counts.
+    std::size_t getMemorySize() const;
+
 private:
     friend class VectorTile;
     friend class VectorTileFeature;
@@ -50,10 +56,46 @@ public:
 
     util::ptr<GeometryTileLayer> getLayer(const std::string&) const override;
 
+    // Estimated from the element counts of the layers.
+    std::size_t getMemorySize() const;
+
 private:
     std::map<std::string, util::ptr<GeometryTileLayer>> layers;
 };
 
+// Owns the raw data of a vector tile and decodes it on first use. The tile at the source's
+// maximum zoom level and all of its overscaled descendants share one instance, so the data is
+// downloaded and decoded only once. get() and release() may be called from several threads at once.
+class SharedVectorTile : private util::noncopyable {
+public:
+    SharedVectorTile(std::string data);
+
+    // The decoded tile stays alive while a caller holds it or until release() is called.
+    std::shared_ptr<const VectorTile> get() const;
+
+    // Drops the decoded tile once all tiles that use it are parsed. It is decoded again if a
+    // tile needs it after that.
+    void release() const;
+
+    // The tiles that hold the data register themselves, so that each of them reports its share
+    // of the memory, and data that several Maps share is counted once in total.
+    void addHolder() const { holders++; }
+    void removeHolder() const { holders--; }
+
+    // Size of the raw data and of the decoded tile while it is kept, divided among the holders.
+    std::size_t getMemoryShare() const;
+
+    // Hash of the raw tile data. Never zero.
+    std::size_t getDataHash() const { return dataHash; }
+
+private:
+    const std::string data;
+    const std::size_t dataHash;
+    mutable std::mutex mutex;
+    mutable std::shared_ptr<const VectorTile> tile;
+    mutable std::atomic<uint32_t> holders { 0 };
+};
+
 }
 
 #endif
@@ -2,6 +2,10 @@
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/style/style_bucket.hpp>
 #include <mbgl/map/source.hpp>
+#include <mbgl/map/bucket_cache.hpp>
+#include <mbgl/map/map_data.hpp>
+#include <mbgl/map/vector_tile.hpp>
+#include <mbgl/map/shared_tile_store.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
@@ -10,13 +14,16 @@
 #include <mbgl/util/work_request.hpp>
 #include <mbgl/style/style.hpp>
 
+#include <algorithm>
+
 using namespace mbgl;
 
 VectorTileData::VectorTileData(const TileID& id_,
                                Style& style_,
                                const SourceInfo& source_,
                                float angle,
-                               bool collisionDebug)
+                               bool collisionDebug,
+                               std::shared_ptr<VectorTileData> sourceTile_)
     : TileData(id_),
       worker(style_.workers),
       tileWorker(id_,
@@ -29,17 +36,46 @@ VectorTileData::VectorTileData(const TileID& id_,
                                     source_.tile_size * id.overscaling,
                                     angle, collisionDebug)),
       source(source_),
+      sourceTile(std::move(sourceTile_)),
       lastAngle(angle),
       currentAngle(angle) {
+    tileWorker.borrowFillBuckets = bool(sourceTile);
+
+    const std::string bucketCachePath = style_.data.getBucketCachePath();
+    if (!bucketCachePath.empty()) {
+        tileWorker.bucketCache = std::make_unique<BucketCache>(bucketCachePath, style_.data.getBucketCacheMaxSize(),
+                                                               style_.getLayoutHash());
+    }
 }
 
 VectorTileData::~VectorTileData() {
     cancel();
+    if (data && !sourceTile) {
+        data->removeHolder();
+    }
 }
 
 void VectorTileData::request(float pixelRatio, const std::function<void()>& callback) {
-    std::string url = source.tileURL(id, pixelRatio);
     state = State::loading;
+    loadedCallback = callback;
+
+    if (sourceTile) {
+        sourceTileCallback = callback;
+        sourceTile->overscaledTiles.push_back(this);
+        sourceTileChanged();
+        return;
+    }
+
+    std::string url = source.tileURL(id, pixelRatio);
+
+    // Reuse the tile when another Map already loaded it.
+    if ((data = SharedTileStore::get().find(url))) {
+        data->addHolder();
+        state = State::loaded;
+        notifyOverscaledTiles();
+        reparse(callback);
+        return;
+    }
 
     FileSource* fs = util::ThreadContext::getFileSource();
     req = fs->request({ Resource::Kind::Tile, url }, util::RunLoop::getLoop(), [url, callback, this](const Response &res) {
@@ -50,12 +86,16 @@ void VectorTileData::request(float pixelRatio, const std::function<void()>& call
             message <<  "Failed to load [" << url << "]: " << res.message;
             error = message.str();
             state = State::obsolete;
+            notifyOverscaledTiles();
             callback();
             return;
         }
 
         state = State::loaded;
-        data = res.data;
+        data = std::make_shared<const SharedVectorTile>(res.data);
+        data->addHolder();
+        SharedTileStore::get().add(url, data);
+        notifyOverscaledTiles();
 
         reparse(callback);
     });
@@ -68,6 +108,13 @@ bool VectorTileData::reparse(std::function<void()> callback) {
 
     parsing = true;
 
+    // Source only reparses the partial tiles it renders, which doesn't include the source tile
+    // of overscaled tiles. If the source tile is already parsing, this tile is reparsed once
+    // that is done; see notifyOverscaledTiles().
+    if (sourceTile && sourceTile->getState() == State::partial) {
+        sourceTile->reparse(sourceTile->loadedCallback);
+    }
+
     workRequest = worker.parseVectorTile(tileWorker, data, [this, callback] (TileParseResult result) {
         parsing = false;
 
@@ -77,6 +124,16 @@ bool VectorTileData::reparse(std::function<void()> callback) {
 
         if (result.is<State>()) {
             state = result.get<State>();
+            updateRevision();
+
+            // Overscaled tiles render the fill buckets of their source tile, so they are only
+            // complete once it is. sourceTileChanged() reparses them when that happens.
+            if (sourceTile && sourceTile->getState() == State::obsolete) {
+                error = sourceTile->getError();
+                state = State::obsolete;
+            } else if (state == State::parsed && sourceTile && sourceTile->getState() != State::parsed) {
+                state = State::partial;
+            }
         } else {
             std::stringstream message;
             message <<  "Failed to parse [" << std::string(id) << "]: " << result.get<std::string>();
@@ -84,17 +141,74 @@ bool VectorTileData::reparse(std::function<void()> callback) {
             state = State::obsolete;
         }
 
+        if (sourceTile) {
+            sourceTile->releaseDecodedTile();
+        } else {
+            notifyOverscaledTiles();
+            releaseDecodedTile();
+        }
+
         callback();
     });
 
     return true;
 }
 
+void VectorTileData::notifyOverscaledTiles() {
+    // Copy the list, since the callbacks can cancel tiles, which removes them from it.
+    const auto tiles = overscaledTiles;
+    for (auto tile : tiles) {
+        tile->sourceTileChanged();
+    }
+}
+
+void VectorTileData::sourceTileChanged() {
+    if (sourceTile->getState() == State::obsolete) {
+        if (state == State::loading || state == State::partial) {
+            error = sourceTile->getError();
+            state = State::obsolete;
+            sourceTileCallback();
+        }
+    } else if (state == State::loading && sourceTile->data) {
+        data = sourceTile->data;
+        state = State::loaded;
+        reparse(sourceTileCallback);
+    } else if (state == State::partial && sourceTile->getState() == State::parsed) {
+        reparse(sourceTileCallback);
+    }
+}
+
+void VectorTileData::releaseDecodedTile() {
+    // The decoded tile is only needed for parsing, which is done once this tile and all
+    // overscaled tiles that share its data are parsed.
+    const auto done = [] (State tileState) {
+        return tileState == State::parsed || tileState == State::obsolete;
+    };
+
+    if (!data || !done(state)) {
+        return;
+    }
+    for (const auto tile : overscaledTiles) {
+        if (!done(tile->state)) {
+            return;
+        }
+    }
+
+    data->release();
+}
+
 Bucket* VectorTileData::getBucket(const StyleLayer& layer) {
     if (!isReady() || !layer.bucket) {
         return nullptr;
     }
 
+    if (tileWorker.borrowFillBuckets && layer.bucket->type == StyleLayerType::Fill) {
+        if (id.z >= std::ceil(layer.bucket->max_zoom)) {
+            return nullptr;
+        }
+        return sourceTile->getBucket(layer);
+    }
+
     return tileWorker.getBucket(layer);
 }
 
@@ -102,6 +216,23 @@ size_t VectorTileData::countBuckets() const {
     return tileWorker.countBuckets();
 }
 
+MemoryFootprint VectorTileData::getMemoryFootprint() const {
+    MemoryFootprint footprint = TileData::getMemoryFootprint();
+    if (isReady()) {
+        footprint += tileWorker.getMemoryFootprint();
+    }
+    // Overscaled tiles share the data of their source tile, which counts it.
+    if (data && !sourceTile) {
+        footprint.cpu += data->getMemoryShare();
+    }
+    return footprint;
+}
+
+uint64_t VectorTileData::getRevision() const {
+    // Revisions only grow, so the larger one changes whenever either tile changes.
+    return sourceTile ? std::max(TileData::getRevision(), sourceTile->getRevision()) : TileData::getRevision();
+}
+
 void VectorTileData::redoPlacement(float angle, bool collisionDebug) {
     if (angle == currentAngle && collisionDebug == currentCollisionDebug)
         return;
@@ -136,5 +267,10 @@ void VectorTileData::cancel() {
         util::ThreadContext::getFileSource()->cancel(req);
         req = nullptr;
     }
+    if (sourceTile) {
+        auto& tiles = sourceTile->overscaledTiles;
+        tiles.erase(std::remove(tiles.begin(), tiles.end(), this), tiles.end());
+        sourceTile->releaseDecodedTile();
+    }
     workRequest.reset();
 }
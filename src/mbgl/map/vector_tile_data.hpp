@@ -12,18 +12,27 @@ class Style;
 class SourceInfo;
 class WorkRequest;
 class Request;
+class SharedVectorTile;
 
 class VectorTileData : public TileData {
 public:
+    // Overscaled tiles pass the tile data at the source's maximum zoom level as sourceTile.
+    // They don't request anything themselves, but parse the data of that tile once it arrives
+    // and render its fill buckets.
     VectorTileData(const TileID&,
                    Style&,
                    const SourceInfo&,
                    float angle_,
-                   bool collisionDebug_);
+                   bool collisionDebug_,
+                   std::shared_ptr<VectorTileData> sourceTile = nullptr);
     ~VectorTileData();
 
     Bucket* getBucket(const StyleLayer&) override;
     size_t countBuckets() const;
+    MemoryFootprint getMemoryFootprint() const override;
+
+    // Includes the revision of the source tile, whose fill buckets overscaled tiles render.
+    uint64_t getRevision() const override;
 
     void request(float pixelRatio,
                  const std::function<void()>& callback);
@@ -35,13 +44,26 @@ public:
     void cancel() override;
 
 private:
+    void notifyOverscaledTiles();
+    void sourceTileChanged();
+    void releaseDecodedTile();
+
     Worker& worker;
     TileWorker tileWorker;
     std::unique_ptr<WorkRequest> workRequest;
     bool parsing = false;
     const SourceInfo& source;
     Request* req = nullptr;
-    std::string data;
+    std::shared_ptr<const SharedVectorTile> data;
+
+    // The callback passed to request(), which tells the Source that this tile changed.
+    std::function<void()> loadedCallback;
+
+    const std::shared_ptr<VectorTileData> sourceTile;
+    std::function<void()> sourceTileCallback;
+
+    // Overscaled tiles that wait for the data of this tile.
+    std::vector<VectorTileData*> overscaledTiles;
     float lastAngle = 0;
     float currentAngle;
     bool lastCollisionDebug = 0;
@@ -1,18 +1,234 @@
 #include <mbgl/platform/log.hpp>
 
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/thread_context.hpp>
 
+#include <array>
+#include <condition_variable>
 #include <cstdarg>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
 namespace {
 
 static std::unique_ptr<Log::Observer> currentObserver;
+static std::atomic<Log::Writer> currentWriter { nullptr };
+
+// Limits warnings and errors per key. Keys are spread over shards, so that threads that record
+// different messages rarely wait for each other.
+class RateLimiter {
+public:
+    struct Suppressed {
+        EventSeverity severity;
+        Event event;
+        uint32_t count;
+    };
+
+    // Returns whether a message with the key may be recorded. If so, `suppressed` is set to
+    // the number of messages with the key that were suppressed since the last recorded one.
+    bool admit(EventSeverity severity, Event event, std::size_t key, uint32_t& suppressed) {
+        const uint32_t max = limit.load(std::memory_order_relaxed);
+        suppressed = 0;
+        if (!max || severity < EventSeverity::Warning) {
+            return true;
+        }
+
+        key ^= std::size_t(event) << 1;
+        Shard& shard = shards[key % shards.size()];
+        const TimePoint now = Clock::now();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Format strings that are built at runtime have an unbounded number of keys.
+        if (shard.windows.size() > 256) {
+            for (auto it = shard.windows.begin(); it != shard.windows.end();) {
+                it = now - it->second.start >= window && !it->second.suppressed ? shard.windows.erase(it) : ++it;
+            }
+        }
+
+        Window& current = shard.windows[key];
+        if (now - current.start >= window) {
+            suppressed = current.suppressed;
+            current = { now, 0, 0, severity, event };
+        }
+        if (current.count < max) {
+            current.count++;
+            return true;
+        } else {
+            current.suppressed++;
+            current.severity = severity;
+            return false;
+        }
+    }
+
+    // Returns the messages that were suppressed since the last recorded one of their key, and
+    // resets their counts.
+    std::vector<Suppressed> takeSuppressed() {
+        std::vector<Suppressed> result;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto& window : shard.windows) {
+                if (window.second.suppressed) {
+                    result.push_back({ window.second.severity, window.second.event, window.second.suppressed });
+                    window.second.suppressed = 0;
+                }
+            }
+        }
+        return result;
+    }
+
+    std::atomic<uint32_t> limit { Log::defaultRateLimit };
+
+private:
+    struct Window {
+        TimePoint start;
+        uint32_t count;
+        uint32_t suppressed;
+        EventSeverity severity;
+        Event event;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::size_t, Window> windows;
+    };
+
+    const Duration window = std::chrono::seconds(1);
+    std::array<Shard, 16> shards;
+};
+
+// Hashes a message that the caller formatted. Digits are skipped, so that messages that only
+// differ in numbers such as tile IDs share a key.
+std::size_t messageKey(const std::string& msg) {
+    std::size_t hash = 14695981039346656037ULL;
+    for (const char c : msg) {
+        if (c < '0' || c > '9') {
+            hash = (hash ^ uint8_t(c)) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+// Never destroyed, so that messages recorded during static destruction are still limited.
+RateLimiter& rateLimiter() {
+    static RateLimiter* instance = new RateLimiter;
+    return *instance;
+}
+
+// Writes messages to the platform log on a thread of its own.
+class Sink {
+public:
+    struct Entry {
+        EventSeverity severity;
+        Event event;
+        int64_t code;
+        std::string threadName;
+        std::string msg;
+    };
+
+    Sink(Log::Writer writer_) : writer(writer_), thread([this] { run(); }) {}
+
+    ~Sink() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        added.notify_one();
+        thread.join();
+    }
+
+    void push(Entry&& entry) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.size() >= maxQueueSize) {
+                dropped++;
+                return;
+            }
+            queue.emplace_back(std::move(entry));
+        }
+        added.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return queue.empty() && !writing; });
+    }
+
+    static std::string format(const Entry& entry) {
+        std::stringstream logStream;
+        logStream << "{" << entry.threadName << "}";
+        logStream << "[" << entry.event << "]";
+
+        if (entry.code >= 0) {
+            logStream << "(" << entry.code << ")";
+        }
+
+        if (!entry.msg.empty()) {
+            logStream << ": " << entry.msg;
+        }
+
+        return logStream.str();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            added.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+
+            std::deque<Entry> entries;
+            entries.swap(queue);
+            const std::size_t droppedEntries = dropped;
+            dropped = 0;
+            writing = true;
+
+            lock.unlock();
+            if (droppedEntries) {
+                writer(EventSeverity::Warning, "{Log}: " + std::to_string(droppedEntries) +
+                                               " messages were dropped because the log queue was full");
+            }
+            for (const auto& entry : entries) {
+                writer(entry.severity, format(entry));
+            }
+            lock.lock();
+
+            writing = false;
+            drained.notify_all();
+        }
+    }
+
+    const Log::Writer writer;
+    static constexpr std::size_t maxQueueSize = 4096;
+
+    std::mutex mutex;
+    std::condition_variable added;
+    std::condition_variable drained;
+    std::deque<Entry> queue;
+    std::size_t dropped = 0;
+    bool writing = false;
+    bool stopping = false;
+
+    std::thread thread;
+};
+
+// Constant initialized, so that it is valid during static initialization and destruction.
+enum class SinkState : uint8_t { Idle, Running, Stopped };
+std::atomic<SinkState> sinkState { SinkState::Idle };
 
 }
 
+std::atomic<uint8_t> Log::minimumSeverity { 0 };
+std::atomic<uint32_t> Log::disabledEventMask { 0 };
+
 void Log::setObserver(std::unique_ptr<Observer> observer) {
     currentObserver = std::move(observer);
 }
@@ -23,18 +239,78 @@ std::unique_ptr<Log::Observer> Log::removeObserver() {
     return observer;
 }
 
+void Log::setMinimumSeverity(EventSeverity severity) {
+    minimumSeverity = uint8_t(severity);
+}
+
+void Log::setEventEnabled(Event event, bool enabled) {
+    if (enabled) {
+        disabledEventMask.fetch_and(~(1u << uint8_t(event)));
+    } else {
+        disabledEventMask.fetch_or(1u << uint8_t(event));
+    }
+}
+
+void Log::setRateLimit(uint32_t count) {
+    rateLimiter().limit = count;
+}
+
+namespace {
+
+// Created on first use. After it was destroyed at exit, messages are written synchronously.
+Sink& getSink(Log::Writer writer) {
+    static struct Holder {
+        Holder(Log::Writer writer_) : sink(writer_) { sinkState = SinkState::Running; }
+        ~Holder() { sinkState = SinkState::Stopped; }
+        Sink sink;
+    } holder(writer);
+    return holder.sink;
+}
+
+}
+
+void Log::setWriter(Writer writer) {
+    currentWriter = writer;
+}
+
+void Log::write(EventSeverity severity, const std::string& msg) {
+    const Writer writer = currentWriter;
+    (writer ? writer : platformRecord)(severity, msg);
+}
+
+void Log::flush() {
+    for (const auto& suppressed : rateLimiter().takeSuppressed()) {
+        deliver(suppressed.severity, suppressed.event, -1,
+                std::to_string(suppressed.count) + " similar messages were suppressed");
+    }
+
+    if (sinkState == SinkState::Running) {
+        getSink(write).flush();
+    }
+}
+
 void Log::record(EventSeverity severity, Event event, const std::string &msg) {
     record(severity, event, -1, msg);
 }
 
 void Log::record(EventSeverity severity, Event event, const char* format, ...) {
+    // Messages are limited by their format string, which is usually a literal, before they are
+    // formatted.
+    uint32_t suppressed;
+    if (!rateLimiter().admit(severity, event, std::hash<const char*>()(format), suppressed)) {
+        return;
+    }
+    if (suppressed) {
+        deliver(severity, event, -1, std::to_string(suppressed) + " similar messages were suppressed");
+    }
+
     va_list args;
     va_start(args, format);
     char msg[4096];
     vsnprintf(msg, sizeof(msg), format, args);
     va_end(args);
 
-    record(severity, event, -1, msg);
+    deliver(severity, event, -1, std::string(msg));
 }
 
 void Log::record(EventSeverity severity, Event event, int64_t code) {
@@ -42,24 +318,40 @@ void Log::record(EventSeverity severity, Event event, int64_t code) {
 }
 
 void Log::record(EventSeverity severity, Event event, int64_t code, const std::string &msg) {
-    if (currentObserver && severity != EventSeverity::Debug &&
-        currentObserver->onRecord(severity, event, code, msg)) {
+    uint32_t suppressed;
+    if (!rateLimiter().admit(severity, event, messageKey(msg) ^ std::hash<int64_t>()(code), suppressed)) {
         return;
     }
+    if (suppressed) {
+        deliver(severity, event, -1, std::to_string(suppressed) + " similar messages were suppressed");
+    }
 
-    std::stringstream logStream;
-    logStream << "{" << util::ThreadContext::getName() << "}";
-    logStream << "[" << event << "]";
+    deliver(severity, event, code, msg);
+}
 
-    if (code >= 0) {
-        logStream << "(" << code << ")";
+void Log::deliver(EventSeverity severity, Event event, int64_t code, const std::string &msg) {
+    if (currentObserver && severity != EventSeverity::Debug &&
+        currentObserver->onRecord(severity, event, code, msg)) {
+        return;
     }
 
-    if (!msg.empty()) {
-        logStream << ": " << msg;
-    }
+    Sink::Entry entry {
+        severity,
+        event,
+        code,
+        util::ThreadContext::hasCurrent() ? util::ThreadContext::getName() : "Unknown",
+        msg
+    };
 
-    platformRecord(severity, logStream.str());
+    if (severity == EventSeverity::Error || event == Event::Crash) {
+        // Keep the order of messages, and write this one before the process might go down.
+        flush();
+        write(severity, Sink::format(entry));
+    } else if (sinkState == SinkState::Stopped) {
+        write(severity, Sink::format(entry));
+    } else {
+        getSink(write).push(std::move(entry));
+    }
 }
 
 }
@@ -1,6 +1,7 @@
 #ifndef MBGL_RENDERER_BUCKET
 #define MBGL_RENDERER_BUCKET
 
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/renderer/render_pass.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -25,6 +26,10 @@ public:
 
     virtual ~Bucket() {}
 
+    // Memory held by the vertices and elements of this bucket, either before or after they
+    // were uploaded, and by the data needed to place its features again.
+    virtual MemoryFootprint getMemoryFootprint() const = 0;
+
     inline bool needsUpload() const {
         return !uploaded;
     }
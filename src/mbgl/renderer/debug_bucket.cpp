@@ -1,4 +1,5 @@
 #include <mbgl/renderer/debug_bucket.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/shader/plain_shader.hpp>
 
@@ -18,6 +19,11 @@ void DebugBucket::upload() {
     uploaded = true;
 }
 
+MemoryFootprint DebugBucket::getMemoryFootprint() const {
+    // The font buffer belongs to the tile.
+    return {};
+}
+
 void DebugBucket::render(Painter& painter, const StyleLayer&, const TileID&, const mat4& matrix) {
     painter.renderDebugText(*this, matrix);
 }
@@ -25,9 +31,11 @@ void DebugBucket::render(Painter& painter, const StyleLayer&, const TileID&, con
 void DebugBucket::drawLines(PlainShader& shader) {
     array.bind(shader, fontBuffer, BUFFER_OFFSET(0));
     MBGL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, (GLsizei)(fontBuffer.index())));
+    gl::stats::drawCall();
 }
 
 void DebugBucket::drawPoints(PlainShader& shader) {
     array.bind(shader, fontBuffer, BUFFER_OFFSET(0));
     MBGL_CHECK_ERROR(glDrawArrays(GL_POINTS, 0, (GLsizei)(fontBuffer.index())));
+    gl::stats::drawCall();
 }
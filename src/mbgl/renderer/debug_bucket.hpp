@@ -17,6 +17,7 @@ public:
 
     void upload() override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
+    MemoryFootprint getMemoryFootprint() const override;
 
     void drawLines(PlainShader& shader);
     void drawPoints(PlainShader& shader);
@@ -1,4 +1,5 @@
 #include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/geometry/fill_buffer.hpp>
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/renderer/painter.hpp>
@@ -9,6 +10,7 @@
 #include <mbgl/shader/outline_shader.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
+#include <mbgl/util/allocation_stats.hpp>
 
 #include <cassert>
 
@@ -17,10 +19,12 @@ struct geometry_too_long_exception : std::exception {};
 using namespace mbgl;
 
 void *FillBucket::alloc(void *, unsigned int size) {
+    allocation::record(size);
     return ::malloc(size);
 }
 
 void *FillBucket::realloc(void *, void *ptr, unsigned int size) {
+    allocation::record(size);
     return ::realloc(ptr, size);
 }
 
@@ -63,6 +67,8 @@ FillBucket::~FillBucket() {
 }
 
 void FillBucket::addGeometry(const GeometryCollection& geometryCollection) {
+    const allocation::TagScope tag(allocation::Tessellate);
+
     for (auto& line_ : geometryCollection) {
         for (auto& v : line_) {
             line.emplace_back(v.x, v.y);
@@ -204,6 +210,24 @@ void FillBucket::upload() {
     uploaded = true;
 }
 
+MemoryFootprint FillBucket::getMemoryFootprint() const {
+    // The vertices of the outlines and of the tessellated triangles are both counted by the
+    // line groups.
+    size_t vertices = 0, lines = 0, triangles = 0;
+    for (const auto& group : lineGroups) {
+        vertices += group->vertex_length;
+        lines += group->elements_length;
+    }
+    for (const auto& group : triangleGroups) {
+        triangles += group->elements_length;
+    }
+
+    MemoryFootprint footprint = vertexBuffer.getMemoryFootprint(vertices);
+    footprint += lineElementsBuffer.getMemoryFootprint(lines);
+    footprint += triangleElementsBuffer.getMemoryFootprint(triangles);
+    return footprint;
+}
+
 void FillBucket::render(Painter& painter,
                         const StyleLayer& layer_desc,
                         const TileID& id,
@@ -222,6 +246,7 @@ void FillBucket::drawElements(PlainShader& shader) {
         assert(group);
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -234,6 +259,7 @@ void FillBucket::drawElements(PatternShader& shader) {
         assert(group);
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -246,6 +272,7 @@ void FillBucket::drawVertices(OutlineShader& shader) {
         assert(group);
         group->array[0].bind(shader, vertexBuffer, lineElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_LINES, group->elements_length * 2, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * lineElementsBuffer.itemSize;
     }
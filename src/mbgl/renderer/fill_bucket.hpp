@@ -19,6 +19,9 @@ class PlainShader;
 class PatternShader;
 
 class FillBucket : public Bucket {
+    // Restores buckets from their cached groups without parsing geometries.
+    friend class BucketCache;
+
 
     static void *alloc(void *data, unsigned int size);
     static void *realloc(void *data, void *ptr, unsigned int size);
@@ -35,6 +38,7 @@ public:
 
     void upload() override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
+    MemoryFootprint getMemoryFootprint() const override;
     bool hasData() const;
 
     void addGeometry(const GeometryCollection&);
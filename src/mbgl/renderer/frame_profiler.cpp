@@ -0,0 +1,220 @@
+#include <mbgl/renderer/frame_profiler.hpp>
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+namespace mbgl {
+
+static gl::ExtensionFunction<
+    void (GLsizei n, GLuint* ids)>
+    GenQueries({
+        {"GL_ARB_timer_query", "glGenQueries"},
+        {"GL_EXT_timer_query", "glGenQueries"},
+        {"GL_EXT_disjoint_timer_query", "glGenQueriesEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLsizei n, const GLuint* ids)>
+    DeleteQueries({
+        {"GL_ARB_timer_query", "glDeleteQueries"},
+        {"GL_EXT_timer_query", "glDeleteQueries"},
+        {"GL_EXT_disjoint_timer_query", "glDeleteQueriesEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLenum target, GLuint id)>
+    BeginQuery({
+        {"GL_ARB_timer_query", "glBeginQuery"},
+        {"GL_EXT_timer_query", "glBeginQuery"},
+        {"GL_EXT_disjoint_timer_query", "glBeginQueryEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLenum target)>
+    EndQuery({
+        {"GL_ARB_timer_query", "glEndQuery"},
+        {"GL_EXT_timer_query", "glEndQuery"},
+        {"GL_EXT_disjoint_timer_query", "glEndQueryEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum pname, GLuint* params)>
+    GetQueryObjectuiv({
+        {"GL_ARB_timer_query", "glGetQueryObjectuiv"},
+        {"GL_EXT_timer_query", "glGetQueryObjectuiv"},
+        {"GL_EXT_disjoint_timer_query", "glGetQueryObjectuivEXT"}
+    });
+
+static gl::ExtensionFunction<
+    void (GLuint id, GLenum pname, uint64_t* params)>
+    GetQueryObjectui64v({
+        {"GL_ARB_timer_query", "glGetQueryObjectui64v"},
+        {"GL_EXT_timer_query", "glGetQueryObjectui64vEXT"},
+        {"GL_EXT_disjoint_timer_query", "glGetQueryObjectui64vEXT"}
+    });
+
+// Stop issuing queries when the driver falls this many frames behind.
+static const std::size_t maxPendingQueries = 8;
+
+FrameProfiler::~FrameProfiler() {
+    if (!timerQueries) {
+        return;
+    }
+
+    for (const auto& queries : pendingQueries) {
+        MBGL_CHECK_ERROR(DeleteQueries(FrameStats::PassCount, queries.ids.data()));
+    }
+    for (const auto& queries : freeQueries) {
+        MBGL_CHECK_ERROR(DeleteQueries(FrameStats::PassCount, queries.ids.data()));
+    }
+}
+
+void FrameProfiler::beginFrame() {
+    timerQueries = GenQueries && DeleteQueries && BeginQuery && EndQuery &&
+                   GetQueryObjectuiv && GetQueryObjectui64v;
+
+    if (timerQueries) {
+        collectGPUTimes();
+    }
+
+    current = FrameStats();
+    current.frame = ++frameCount;
+    current.start = Clock::now();
+
+    counters = gl::stats::Counters();
+    gl::stats::install(&counters);
+
+    allocations = allocation::Counters();
+    previousAllocations = allocation::install(&allocations);
+
+    activeQueries = nullptr;
+    if (timerQueries && pendingQueries.size() < maxPendingQueries) {
+        if (freeQueries.empty()) {
+            Queries queries;
+            MBGL_CHECK_ERROR(GenQueries(FrameStats::PassCount, queries.ids.data()));
+            freeQueries.push_back(queries);
+        }
+
+        pendingQueries.push_back(freeQueries.back());
+        freeQueries.pop_back();
+
+        activeQueries = &pendingQueries.back();
+        activeQueries->frame = current.frame;
+        activeQueries->used.fill(false);
+    }
+}
+
+void FrameProfiler::endFrame() {
+    gl::stats::install(nullptr);
+    allocation::install(previousAllocations);
+
+    current.drawCalls = counters.drawCalls;
+    current.uploads = counters.uploads;
+    current.bytesUploaded = counters.bytesUploaded;
+
+    const allocation::Counter total = allocations.total();
+    current.allocations = total.allocations;
+    current.bytesAllocated = total.bytes;
+
+    last = current;
+    if (historySize) {
+        history.push_back(current);
+        while (history.size() > historySize) {
+            history.pop_front();
+        }
+    }
+}
+
+FrameProfiler::PassScope::PassScope(FrameProfiler& profiler_, FrameStats::Pass pass_)
+    : profiler(profiler_), pass(pass_), start(Clock::now())
+#ifndef MBGL_DISABLE_TRACING
+    , trace("render", FrameStats::passName(pass_))
+#endif
+{
+    if (profiler.activeQueries) {
+        MBGL_CHECK_ERROR(BeginQuery(GL_TIME_ELAPSED, profiler.activeQueries->ids[pass]));
+        profiler.activeQueries->used[pass] = true;
+    }
+}
+
+FrameProfiler::PassScope::~PassScope() {
+    if (profiler.activeQueries) {
+        MBGL_CHECK_ERROR(EndQuery(GL_TIME_ELAPSED));
+    }
+    profiler.current.cpuTime[pass] += Clock::now() - start;
+}
+
+void FrameProfiler::collectGPUTimes() {
+    while (!pendingQueries.empty()) {
+        Queries& queries = pendingQueries.front();
+
+        // Queries complete in order, so the last pass that was measured finishes last.
+        int lastUsed = FrameStats::PassCount - 1;
+        while (lastUsed >= 0 && !queries.used[lastUsed]) {
+            lastUsed--;
+        }
+
+        if (lastUsed >= 0) {
+            GLuint available = 0;
+            MBGL_CHECK_ERROR(GetQueryObjectuiv(queries.ids[lastUsed], GL_QUERY_RESULT_AVAILABLE, &available));
+            if (!available) {
+                return;
+            }
+        }
+
+        FrameStats* stats = find(queries.frame);
+        for (std::size_t pass = 0; pass < FrameStats::PassCount; ++pass) {
+            if (!queries.used[pass]) {
+                continue;
+            }
+
+            uint64_t elapsed = 0;
+            MBGL_CHECK_ERROR(GetQueryObjectui64v(queries.ids[pass], GL_QUERY_RESULT, &elapsed));
+            if (stats) {
+                stats->gpuTime[pass] = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(elapsed));
+            }
+        }
+
+        if (stats) {
+            stats->gpuTimeAvailable = true;
+            if (stats != &last && last.frame == queries.frame) {
+                last = *stats;
+            }
+        }
+
+        freeQueries.push_back(queries);
+        pendingQueries.pop_front();
+    }
+}
+
+FrameStats* FrameProfiler::find(uint64_t frame) {
+    for (auto& stats : history) {
+        if (stats.frame == frame) {
+            return &stats;
+        }
+    }
+    if (last.frame == frame) {
+        return &last;
+    }
+    return nullptr;
+}
+
+void FrameProfiler::setHistorySize(std::size_t size) {
+    historySize = size;
+    while (history.size() > historySize) {
+        history.pop_front();
+    }
+}
+
+std::vector<FrameStats> FrameProfiler::getHistory() const {
+    return { history.begin(), history.end() };
+}
+
+}
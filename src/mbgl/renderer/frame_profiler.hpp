@@ -0,0 +1,79 @@
+#ifndef MBGL_RENDERER_FRAME_PROFILER
+#define MBGL_RENDERER_FRAME_PROFILER
+
+#include <mbgl/map/frame_stats.hpp>
+#include <mbgl/gl/stats.hpp>
+#include <mbgl/platform/gl.hpp>
+#include <mbgl/util/allocation_stats.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/trace.hpp>
+
+#include <deque>
+#include <vector>
+
+namespace mbgl {
+
+// Collects FrameStats for the frames rendered by a Painter. CPU times are measured with the
+// steady clock. GPU times are measured with GL_TIME_ELAPSED queries when the driver supports
+// them; their results are polled at the start of later frames, so they never stall rendering.
+class FrameProfiler : private util::noncopyable {
+public:
+    ~FrameProfiler();
+
+    void beginFrame();
+    void endFrame();
+
+    class PassScope {
+    public:
+        PassScope(FrameProfiler&, FrameStats::Pass);
+        ~PassScope();
+
+    private:
+        FrameProfiler& profiler;
+        const FrameStats::Pass pass;
+        const TimePoint start;
+#ifndef MBGL_DISABLE_TRACING
+        const trace::Scope trace;
+#endif
+    };
+
+    void countTiles(std::size_t count) { current.tiles += count; }
+    void countBucket() { current.buckets++; }
+
+    // The stats of the most recently completed frame.
+    const FrameStats& getLastFrame() const { return last; }
+
+    // Keeps the stats of the last `size` frames around. Zero disables the history.
+    void setHistorySize(std::size_t size);
+    std::vector<FrameStats> getHistory() const;
+
+private:
+    void collectGPUTimes();
+    FrameStats* find(uint64_t frame);
+
+    struct Queries {
+        uint64_t frame = 0;
+        std::array<GLuint, FrameStats::PassCount> ids {{}};
+        std::array<bool, FrameStats::PassCount> used {{}};
+    };
+
+    FrameStats current;
+    FrameStats last;
+    uint64_t frameCount = 0;
+
+    gl::stats::Counters counters;
+    allocation::Counters allocations;
+    allocation::Counters* previousAllocations = nullptr;
+
+    bool timerQueries = false;
+    Queries* activeQueries = nullptr;
+    std::deque<Queries> pendingQueries;
+    std::vector<Queries> freeQueries;
+
+    std::deque<FrameStats> history;
+    std::size_t historySize = 0;
+};
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/gl/stats.hpp>
 
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/renderer/painter.hpp>
@@ -7,6 +8,7 @@
 #include <mbgl/shader/line_shader.hpp>
 #include <mbgl/shader/linesdf_shader.hpp>
 #include <mbgl/shader/linepattern_shader.hpp>
+#include <mbgl/util/allocation_stats.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/platform/gl.hpp>
 
@@ -32,6 +34,8 @@ void LineBucket::addGeometry(const GeometryCollection& geometryCollection) {
 }
 
 void LineBucket::addGeometry(const std::vector<Coordinate>& vertices) {
+    const allocation::TagScope tag(allocation::Tessellate);
+
     const auto len = [&vertices] {
         auto l = vertices.size();
         // If the line has duplicate vertices at the end, adjust length to remove them.
@@ -394,6 +398,18 @@ void LineBucket::upload() {
     uploaded = true;
 }
 
+MemoryFootprint LineBucket::getMemoryFootprint() const {
+    size_t vertices = 0, triangles = 0;
+    for (const auto& group : triangleGroups) {
+        vertices += group->vertex_length;
+        triangles += group->elements_length;
+    }
+
+    MemoryFootprint footprint = vertexBuffer.getMemoryFootprint(vertices);
+    footprint += triangleElementsBuffer.getMemoryFootprint(triangles);
+    return footprint;
+}
+
 void LineBucket::render(Painter& painter,
                         const StyleLayer& layer_desc,
                         const TileID& id,
@@ -416,6 +432,7 @@ void LineBucket::drawLines(LineShader& shader) {
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
                                         elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -432,6 +449,7 @@ void LineBucket::drawLineSDF(LineSDFShader& shader) {
         group->array[2].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
                                         elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -448,6 +466,7 @@ void LineBucket::drawLinePatterns(LinepatternShader& shader) {
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
                                         elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
         elements_index += group->elements_length * triangleElementsBuffer.itemSize;
     }
@@ -22,6 +22,8 @@ class LineSDFShader;
 class LinepatternShader;
 
 class LineBucket : public Bucket {
+    friend class BucketCache;
+
     using TriangleGroup = ElementGroup<3>;
 
 public:
@@ -30,6 +32,7 @@ public:
 
     void upload() override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
+    MemoryFootprint getMemoryFootprint() const override;
     bool hasData() const;
 
     void addGeometry(const GeometryCollection&);
@@ -2,10 +2,12 @@
 
 #include <mbgl/map/source.hpp>
 #include <mbgl/map/tile.hpp>
+#include <mbgl/map/tile_data.hpp>
 #include <mbgl/map/map_context.hpp>
 
 #include <mbgl/platform/log.hpp>
 #include <mbgl/gl/debugging.hpp>
+#include <mbgl/gl/stats.hpp>
 
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_layer.hpp>
@@ -28,6 +30,7 @@
 #include <mbgl/shader/gaussian_shader.hpp>
 #include <mbgl/shader/box_shader.hpp>
 
+#include <mbgl/util/allocation_stats.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mat3.hpp>
 
@@ -38,6 +41,8 @@
 #include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <tuple>
 
 using namespace mbgl;
 
@@ -116,6 +121,18 @@ void Painter::setDebug(bool enabled) {
     debug = enabled;
 }
 
+void Painter::setTileRenderCacheSize(size_t size) {
+    tileRenderCache.setSize(size);
+}
+
+void Painter::clearTileRenderCache() {
+    tileRenderCache.clear();
+}
+
+MemoryFootprint Painter::getTileRenderCacheFootprint() const {
+    return tileRenderCache.getMemoryFootprint();
+}
+
 void Painter::useProgram(uint32_t program) {
     if (gl_program != program) {
         MBGL_CHECK_ERROR(glUseProgram(program));
@@ -166,6 +183,8 @@ void Painter::prepareTile(const Tile& tile) {
 }
 
 void Painter::render(const Style& style, TransformState state_, const FrameData& frame_, TimePoint time) {
+    frameProfiler.beginFrame();
+
     state = state_;
     frame = frame_;
 
@@ -186,10 +205,18 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Figure out what buckets we have to draw and what order we have to draw them in.
     const auto order = determineRenderOrder(style);
 
+    RenderItemIterator cachedBegin = order.end();
+    RenderItemIterator cachedEnd = order.end();
+    if (tileRenderCache.getSize()) {
+        std::tie(cachedBegin, cachedEnd) = determineCachedRange(order);
+    }
+
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
     {
         const gl::debugging::group upload("upload");
+        const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Upload);
+        const allocation::TagScope tag(allocation::Upload);
 
         tileStencilBuffer.upload();
         tileBorderBuffer.upload();
@@ -205,15 +232,31 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     }
 
 
+    // - TILE RENDER CACHE -------------------------------------------------------------------------
+    // Renders the cacheable layers of tiles that aren't in the cache yet into textures.
+    std::vector<CachedTile> cachedTiles;
+    if (cachedBegin != cachedEnd) {
+        const gl::debugging::group tileCache("tile cache");
+        const FrameProfiler::PassScope profile(frameProfiler, FrameStats::TileCache);
+
+        cachedTiles = renderTileCache(style, cachedBegin, cachedEnd);
+        if (cachedTiles.empty()) {
+            cachedBegin = cachedEnd = order.end();
+        }
+    }
+
     // - CLIPPING MASKS ----------------------------------------------------------------------------
     // Draws the clipping masks to the stencil buffer.
     {
         const gl::debugging::group clip("clip");
+        const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Clipping);
 
         // Update all clipping IDs.
         ClipIDGenerator generator;
         for (const auto& source : sources) {
-            generator.update(source->getLoadedTiles());
+            const auto tiles = source->getLoadedTiles();
+            frameProfiler.countTiles(std::distance(tiles.begin(), tiles.end()));
+            generator.update(tiles);
             source->updateMatrices(projMatrix, state);
         }
 
@@ -227,20 +270,64 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Actually render the layers
     if (debug::renderTree) { Log::Info(Event::Render, "{"); indent++; }
 
-    // TODO: Correctly compute the number of layers recursively beforehand.
-    const float strataThickness = 1.0f / (order.size() + 1);
+    if (cachedTiles.empty()) {
+        // TODO: Correctly compute the number of layers recursively beforehand.
+        const float strataThickness = 1.0f / (order.size() + 1);
+
+        // - OPAQUE PASS ---------------------------------------------------------------------------
+        // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
+        {
+            const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Opaque);
+            renderPass(RenderPass::Opaque,
+                       order.rbegin(), order.rend(),
+                       0, 1, strataThickness);
+        }
 
-    // - OPAQUE PASS -------------------------------------------------------------------------------
-    // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
-    renderPass(RenderPass::Opaque,
-               order.rbegin(), order.rend(),
-               0, 1, strataThickness);
+        // - TRANSLUCENT PASS ----------------------------------------------------------------------
+        // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
+        {
+            const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Translucent);
+            renderPass(RenderPass::Translucent,
+                       order.begin(), order.end(),
+                       order.size() - 1, -1, strataThickness);
+        }
+    } else {
+        // The cached layers are replaced by a single stratum in which the tile textures are
+        // composited. Everything else is rendered as usual.
+        using ReverseIterator = std::vector<RenderItem>::const_reverse_iterator;
+        const std::size_t below = cachedBegin - order.begin();
+        const std::size_t above = order.end() - cachedEnd;
+        const float strataThickness = 1.0f / (below + above + 2);
+
+        // - OPAQUE PASS ---------------------------------------------------------------------------
+        {
+            const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Opaque);
+            renderPass(RenderPass::Opaque,
+                       order.rbegin(), ReverseIterator(cachedEnd),
+                       0, 1, strataThickness);
+            renderPass(RenderPass::Opaque,
+                       ReverseIterator(cachedBegin), order.rend(),
+                       above + 1, 1, strataThickness);
+        }
 
-    // - TRANSLUCENT PASS --------------------------------------------------------------------------
-    // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
-    renderPass(RenderPass::Translucent,
-               order.begin(), order.end(),
-               order.size() - 1, -1, strataThickness);
+        // - TRANSLUCENT PASS ----------------------------------------------------------------------
+        {
+            const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Translucent);
+            renderPass(RenderPass::Translucent,
+                       order.begin(), cachedBegin,
+                       below + above, -1, strataThickness);
+            {
+                const gl::debugging::group group("cached tiles");
+                setStrata(above * strataThickness);
+                for (const auto& cachedTile : cachedTiles) {
+                    renderTileTexture(*cachedTile.first, cachedTile.second);
+                }
+            }
+            renderPass(RenderPass::Translucent,
+                       cachedEnd, order.end(),
+                       above - 1, -1, strataThickness);
+        }
+    }
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
@@ -248,6 +335,7 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
     // Renders debug overlays.
     {
         const gl::debugging::group _("debug");
+        const FrameProfiler::PassScope profile(frameProfiler, FrameStats::Debug);
 
         // Finalize the rendering, e.g. by calling debug render calls per tile.
         // This guarantees that we have at least one function per tile called.
@@ -266,6 +354,8 @@ void Painter::render(const Style& style, TransformState state_, const FrameData&
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, 0));
         MBGL_CHECK_ERROR(VertexArrayObject::Unbind());
     }
+
+    frameProfiler.endFrame();
 }
 
 template <class Iterator>
@@ -291,7 +381,9 @@ void Painter::renderPass(RenderPass pass_,
                 const gl::debugging::group group(item.layer.id + " - " + std::string(item.tile->id));
                 setStrata(i * strataThickness);
                 prepareTile(*item.tile);
+                tileOpacity = item.tile->opacity;
                 item.bucket->render(*this, item.layer, item.tile->id, item.tile->matrix);
+                frameProfiler.countBucket();
             }
         } else {
             const gl::debugging::group group("background");
@@ -363,6 +455,186 @@ std::vector<RenderItem> Painter::determineRenderOrder(const Style& style) {
     return order;
 }
 
+std::pair<Painter::RenderItemIterator, Painter::RenderItemIterator>
+Painter::determineCachedRange(const std::vector<RenderItem>& order) {
+    // Only the layers between the backgrounds and the first symbol layer are cached, and only
+    // as long as they come from the same source: tiles of different sources don't line up, and
+    // labels have to be placed and drawn on top of the cached layers every time.
+    const auto begin = std::find_if(order.begin(), order.end(), [](const RenderItem& item) {
+        return item.bucket;
+    });
+
+    auto end = begin;
+    while (end != order.end() && end->bucket &&
+           end->layer.type != StyleLayerType::Symbol &&
+           end->layer.bucket->source == begin->layer.bucket->source) {
+        ++end;
+    }
+
+    return { begin, end };
+}
+
+std::vector<Painter::CachedTile> Painter::renderTileCache(const Style& style, RenderItemIterator begin, RenderItemIterator end) {
+    std::vector<CachedTile> result;
+
+    std::vector<const Tile*> tiles;
+    for (auto it = begin; it != end; ++it) {
+        if (std::find(tiles.begin(), tiles.end(), it->tile) == tiles.end()) {
+            tiles.push_back(it->tile);
+        }
+    }
+
+    // Rendering a tile into a texture and compositing it only produces the same image when the
+    // tile is axis-aligned and covers whole pixels.
+    if (tiles.size() > tileRenderCache.getSize() || state.getAngle() != 0) {
+        return result;
+    }
+
+    Source* source = style.getSource(begin->layer.bucket->source);
+    assert(source);
+    source->updateMatrices(projMatrix, state);
+
+    GLint maxTextureSize = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+    maxTextureSize = std::min<GLint>(maxTextureSize, std::numeric_limits<uint16_t>::max());
+
+    const auto aligned = [](double value) {
+        return std::abs(value - std::round(value)) < 0.05;
+    };
+
+    std::vector<std::array<uint16_t, 2>> sizes;
+    for (const auto tile : tiles) {
+        // Without rotation, the tile matrix only scales and translates.
+        const mat4& m = tile->matrix;
+        const double left = (m[12] + 1) / 2 * frame.framebufferSize[0];
+        const double top = (m[13] + 1) / 2 * frame.framebufferSize[1];
+        const double width = m[0] * 4096 / 2 * frame.framebufferSize[0];
+        const double height = std::abs(m[5] * 4096 / 2 * frame.framebufferSize[1]);
+
+        if (!aligned(left) || !aligned(top) || !aligned(width) || !aligned(height) ||
+            width < 1 || height < 1 || width > maxTextureSize || height > maxTextureSize) {
+            return result;
+        }
+
+        sizes.push_back({{ static_cast<uint16_t>(std::round(width)), static_cast<uint16_t>(std::round(height)) }});
+    }
+
+    // Look up all tiles before rendering the missing ones so that rendering a tile into the
+    // cache never evicts a texture that this frame needs.
+    const double zoom = state.getZoom();
+    std::vector<TileRenderCache::Key> keys;
+    std::vector<const TileRenderCache::Texture*> textures;
+    for (const auto tile : tiles) {
+        keys.push_back({ tile->id, zoom, style.getHash(), tile->data->getRevision() });
+        textures.push_back(tileRenderCache.get(keys.back()));
+    }
+
+    bool rendered = false;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        if (!textures[i]) {
+            renderTileToTexture(*tiles[i], keys[i], sizes[i][0], sizes[i][1], begin, end);
+            rendered = true;
+        }
+    }
+
+    if (rendered) {
+        // Restore the state for rendering to the view.
+        gl_viewport = {{ 0, 0 }};
+        resize();
+        changeMatrix();
+    }
+
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const auto texture = tileRenderCache.get(keys[i]);
+        assert(texture);
+        result.emplace_back(tiles[i], *texture);
+    }
+
+    return result;
+}
+
+void Painter::renderTileToTexture(const Tile& tile, const TileRenderCache::Key& key, uint16_t width, uint16_t height,
+                                  RenderItemIterator begin, RenderItemIterator end) {
+    const gl::debugging::group group(std::string(tile.id));
+
+    std::vector<const RenderItem*> items;
+    for (auto it = begin; it != end; ++it) {
+        if (it->tile == &tile) {
+            items.push_back(&*it);
+        }
+    }
+
+    const FrameData viewFrame = frame;
+
+    tileRenderCache.beginRender(key, width, height);
+
+    MBGL_CHECK_ERROR(glViewport(0, 0, width, height));
+    gl_viewport = {{ width, height }};
+    frame.framebufferSize = {{ width, height }};
+
+    // Render the tile upside down so that the first row of the texture is the top of the tile,
+    // which is what the raster shader expects when compositing it with flipMatrix.
+    matrix::ortho(projMatrix, 0, width / pixelRatio, 0, height / pixelRatio, 0, 1);
+    extrudeMatrix = projMatrix;
+
+    // The texture framebuffer doesn't have a stencil buffer, so clipping is a no-op here. The
+    // viewport clips to the tile boundary instead.
+    config.depthMask = GL_TRUE;
+    config.clearColor = { 0.0f, 0.0f, 0.0f, 0.0f };
+    MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+    const float strataThickness = 1.0f / (items.size() + 1);
+
+    pass = RenderPass::Opaque;
+    config.blend = false;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const RenderItem& item = *items[items.size() - 1 - i];
+        if (item.hasRenderPass(pass)) {
+            setStrata(i * strataThickness);
+            item.bucket->render(*this, item.layer, tile.id, flipMatrix);
+            frameProfiler.countBucket();
+        }
+    }
+
+    pass = RenderPass::Translucent;
+    config.blend = true;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const RenderItem& item = *items[i];
+        if (item.hasRenderPass(pass)) {
+            setStrata((items.size() - 1 - i) * strataThickness);
+            item.bucket->render(*this, item.layer, tile.id, flipMatrix);
+            frameProfiler.countBucket();
+        }
+    }
+
+    tileRenderCache.endRender();
+    frame = viewFrame;
+}
+
+void Painter::renderTileTexture(const Tile& tile, const TileRenderCache::Texture& texture) {
+    useProgram(rasterShader->program);
+    rasterShader->u_matrix = tile.matrix;
+    rasterShader->u_buffer = 0;
+    rasterShader->u_image = 0;
+    rasterShader->u_opacity = 1.0f;
+    rasterShader->u_brightness_low = 0.0f;
+    rasterShader->u_brightness_high = 1.0f;
+    rasterShader->u_saturation_factor = saturationFactor(0.0f);
+    rasterShader->u_contrast_factor = contrastFactor(0.0f);
+    rasterShader->u_spin_weights = spinWeights(0.0f);
+
+    config.stencilTest = true;
+    config.depthTest = true;
+    config.depthRange = { strata + strata_epsilon, 1.0f };
+    prepareTile(tile);
+
+    MBGL_CHECK_ERROR(glActiveTexture(GL_TEXTURE0));
+    MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.texture));
+    coveringRasterArray.bind(*rasterShader, tileStencilBuffer, BUFFER_OFFSET(0));
+    MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLES, 0, (GLsizei)tileStencilBuffer.index()));
+    gl::stats::drawCall();
+}
+
 RenderPass Painter::determineRenderPasses(const StyleLayer& layer) {
     RenderPass passes = RenderPass::None;
 
@@ -463,6 +735,7 @@ void Painter::renderBackground(const StyleLayer &layer_desc) {
     config.depthTest = true;
     config.depthRange = { strata + strata_epsilon, 1.0f };
     MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+    gl::stats::drawCall();
 }
 
 mat4 Painter::translatedMatrix(const mat4& matrix, const std::array<float, 2> &translation, const TileID &id, TranslateAnchorType anchor) {
@@ -5,7 +5,9 @@
 #include <mbgl/map/map_context.hpp>
 
 #include <mbgl/renderer/frame_history.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
 #include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/tile_render_cache.hpp>
 
 #include <mbgl/geometry/vao.hpp>
 #include <mbgl/geometry/static_vertex_buffer.hpp>
@@ -127,6 +129,12 @@ public:
     // Changes whether debug information is drawn onto the map
     void setDebug(bool enabled);
 
+    // Sets the number of tiles whose rendered non-symbol layers are kept between renders.
+    // Zero disables the cache, which should only be enabled for still images.
+    void setTileRenderCacheSize(size_t);
+    void clearTileRenderCache();
+    MemoryFootprint getTileRenderCacheFootprint() const;
+
     // Configures the painter strata that is used for early z-culling of fragments.
     void setStrata(float strata);
 
@@ -148,6 +156,19 @@ private:
     std::vector<RenderItem> determineRenderOrder(const Style& style);
     static RenderPass determineRenderPasses(const StyleLayer&);
 
+    using RenderItemIterator = std::vector<RenderItem>::const_iterator;
+    using CachedTile = std::pair<const Tile*, TileRenderCache::Texture>;
+
+    // Returns the range of render items that can be drawn from the tile render cache.
+    static std::pair<RenderItemIterator, RenderItemIterator> determineCachedRange(const std::vector<RenderItem>&);
+
+    // Makes sure that all tiles of the given render items are in the tile render cache and
+    // returns their textures. Returns an empty vector if the tiles can't be cached.
+    std::vector<CachedTile> renderTileCache(const Style&, RenderItemIterator begin, RenderItemIterator end);
+    void renderTileToTexture(const Tile&, const TileRenderCache::Key&, uint16_t width, uint16_t height,
+                             RenderItemIterator begin, RenderItemIterator end);
+    void renderTileTexture(const Tile&, const TileRenderCache::Texture&);
+
     template <class Iterator>
     void renderPass(RenderPass,
                     Iterator it, Iterator end,
@@ -205,11 +226,15 @@ private:
     float gl_lineWidth = 0;
     std::array<uint16_t, 2> gl_viewport = {{ 0, 0 }};
     float strata = 0;
+    float tileOpacity = 1;
     RenderPass pass = RenderPass::Opaque;
     const float strata_epsilon = 1.0f / (1 << 16);
 
+    TileRenderCache tileRenderCache;
+
 public:
     FrameHistory frameHistory;
+    FrameProfiler frameProfiler;
 
     SpriteAtlas* spriteAtlas;
     GlyphAtlas* glyphAtlas;
@@ -1,4 +1,5 @@
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/map/source.hpp>
 #include <mbgl/shader/plain_shader.hpp>
 #include <mbgl/util/clip_id.hpp>
@@ -36,4 +37,5 @@ void Painter::drawClippingMask(const mat4& matrix, const ClipID &clip) {
     config.stencilFunc = { GL_ALWAYS, ref, mask };
     config.stencilMask = mask;
     MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLES, 0, (GLsizei)tileStencilBuffer.index()));
+    gl::stats::drawCall();
 }
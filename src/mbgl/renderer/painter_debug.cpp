@@ -1,4 +1,5 @@
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/renderer/debug_bucket.hpp>
 #include <mbgl/map/tile.hpp>
 #include <mbgl/map/tile_data.hpp>
@@ -62,4 +63,5 @@ void Painter::renderDebugFrame(const mat4 &matrix) {
     plainShader->u_color = {{ 1.0f, 0.0f, 0.0f, 1.0f }};
     lineWidth(4.0f * pixelRatio);
     MBGL_CHECK_ERROR(glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)tileBorderBuffer.index()));
+    gl::stats::drawCall();
 }
@@ -15,14 +15,15 @@ void Painter::renderRaster(RasterBucket& bucket, const StyleLayer &layer_desc, c
         useProgram(rasterShader->program);
         rasterShader->u_matrix = matrix;
         rasterShader->u_buffer = 0;
-        rasterShader->u_opacity = properties.opacity;
+        rasterShader->u_opacity = properties.opacity * tileOpacity;
         rasterShader->u_brightness_low = properties.brightness[0];
         rasterShader->u_brightness_high = properties.brightness[1];
         rasterShader->u_saturation_factor = saturationFactor(properties.saturation);
         rasterShader->u_contrast_factor = contrastFactor(properties.contrast);
         rasterShader->u_spin_weights = spinWeights(properties.hue_rotate);
 
-        config.stencilTest = true;
+        // Tiles that fade in are drawn over their placeholder, which isn't clipped for them.
+        config.stencilTest = tileOpacity >= 1;
         config.depthTest = true;
         config.depthRange = { strata + strata_epsilon, 1.0f };
         bucket.drawRaster(*rasterShader, tileStencilBuffer, coveringRasterArray);
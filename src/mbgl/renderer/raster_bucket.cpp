@@ -1,4 +1,5 @@
 #include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/shader/raster_shader.hpp>
 #include <mbgl/renderer/painter.hpp>
 
@@ -16,6 +17,10 @@ void RasterBucket::upload() {
     }
 }
 
+MemoryFootprint RasterBucket::getMemoryFootprint() const {
+    return raster.getMemoryFootprint();
+}
+
 void RasterBucket::render(Painter& painter,
                           const StyleLayer& layer_desc,
                           const TileID& id,
@@ -32,6 +37,7 @@ void RasterBucket::drawRaster(RasterShader& shader, StaticVertexBuffer &vertices
     shader.u_image = 0;
     array.bind(shader, vertices, BUFFER_OFFSET(0));
     MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.index()));
+    gl::stats::drawCall();
 }
 
 bool RasterBucket::hasData() const {
@@ -18,6 +18,7 @@ public:
 
     void upload() override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
+    MemoryFootprint getMemoryFootprint() const override;
     bool hasData() const;
 
     bool setImage(std::unique_ptr<util::Image> image);
@@ -1,4 +1,5 @@
 #include <mbgl/renderer/symbol_bucket.hpp>
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/map/geometry_tile.hpp>
 #include <mbgl/style/style_layout.hpp>
 #include <mbgl/annotation/sprite_image.hpp>
@@ -18,6 +19,7 @@
 #include <mbgl/shader/box_shader.hpp>
 #include <mbgl/map/sprite.hpp>
 
+#include <mbgl/util/allocation_stats.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/token.hpp>
 #include <mbgl/util/math.hpp>
@@ -74,6 +76,31 @@ void SymbolBucket::upload() {
     uploaded = true;
 }
 
+MemoryFootprint SymbolBucket::getMemoryFootprint() const {
+    MemoryFootprint footprint;
+
+    // Placement runs again whenever the map rotates, so the symbol instances are kept.
+    footprint.cpu += symbolInstances.capacity() * sizeof(SymbolInstance);
+    for (const auto& symbol : symbolInstances) {
+        footprint.cpu += (symbol.glyphQuads.capacity() + symbol.iconQuads.capacity()) * sizeof(SymbolQuad);
+        footprint.cpu += (symbol.textCollisionFeature.boxes.capacity() +
+                          symbol.iconCollisionFeature.boxes.capacity()) * sizeof(CollisionBox);
+    }
+
+    // The render data that is being placed on a worker thread is left out, because it may
+    // change while this runs.
+    std::lock_guard<std::mutex> lock(renderDataMutex);
+    if (renderData) {
+        footprint += renderData->text.vertices.getMemoryFootprint();
+        footprint += renderData->text.triangles.getMemoryFootprint();
+        footprint += renderData->icon.vertices.getMemoryFootprint();
+        footprint += renderData->icon.triangles.getMemoryFootprint();
+        footprint += renderData->collisionBox.vertices.getMemoryFootprint();
+    }
+
+    return footprint;
+}
+
 void SymbolBucket::render(Painter& painter,
                           const StyleLayer& layer_desc,
                           const TileID& id,
@@ -175,6 +202,8 @@ void SymbolBucket::addFeatures(uintptr_t tileUID,
                                SpriteAtlas& spriteAtlas,
                                GlyphAtlas& glyphAtlas,
                                GlyphStore& glyphStore) {
+    const allocation::TagScope tag(allocation::Shape);
+
     float horizontalAlign = 0.5;
     float verticalAlign = 0.5;
 
@@ -240,7 +269,7 @@ void SymbolBucket::addFeatures(uintptr_t tileUID,
 
             // Add the glyphs we need for this label to the glyph atlas.
             if (shapedText) {
-                glyphAtlas.addGlyphs(tileUID, feature.label, layout.text.font, **fontStack, face);
+                glyphAtlas.addGlyphs(tileUID, feature.label, layout.text.font, *fontStack, face);
             }
         }
 
@@ -337,6 +366,7 @@ void SymbolBucket::placeFeatures() {
 }
 
 void SymbolBucket::placeFeatures(bool swapImmediately) {
+    const allocation::TagScope tag(allocation::Place);
 
     renderDataInProgress = std::make_unique<SymbolRenderData>();
 
@@ -541,6 +571,7 @@ void SymbolBucket::addToDebugBuffers() {
 }
 
 void SymbolBucket::swapRenderData() {
+    std::lock_guard<std::mutex> lock(renderDataMutex);
     renderData = std::move(renderDataInProgress);
 }
 
@@ -552,6 +583,7 @@ void SymbolBucket::drawGlyphs(SDFShader &shader) {
         assert(group);
         group->array[0].bind(shader, text.vertices, text.triangles, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * text.vertices.itemSize;
         elements_index += group->elements_length * text.triangles.itemSize;
     }
@@ -565,6 +597,7 @@ void SymbolBucket::drawIcons(SDFShader &shader) {
         assert(group);
         group->array[0].bind(shader, icon.vertices, icon.triangles, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * icon.vertices.itemSize;
         elements_index += group->elements_length * icon.triangles.itemSize;
     }
@@ -578,6 +611,7 @@ void SymbolBucket::drawIcons(IconShader &shader) {
         assert(group);
         group->array[1].bind(shader, icon.vertices, icon.triangles, vertex_index);
         MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        gl::stats::drawCall();
         vertex_index += group->vertex_length * icon.vertices.itemSize;
         elements_index += group->elements_length * icon.triangles.itemSize;
     }
@@ -589,6 +623,7 @@ void SymbolBucket::drawCollisionBoxes(CollisionBoxShader &shader) {
     for (auto &group : collisionBox.groups) {
         group->array[0].bind(shader, collisionBox.vertices, vertex_index);
         MBGL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, group->vertex_length));
+        gl::stats::drawCall();
     }
 }
 }
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace mbgl {
@@ -69,6 +70,7 @@ public:
 
     void upload() override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
+    MemoryFootprint getMemoryFootprint() const override;
     bool hasData() const;
     bool hasTextData() const;
     bool hasIconData() const;
@@ -135,6 +137,10 @@ private:
 
     std::unique_ptr<SymbolRenderData> renderData;
     std::unique_ptr<SymbolRenderData> renderDataInProgress;
+
+    // Guards replacing renderData against getMemoryFootprint(), which may run on another
+    // thread. Rendering runs on the thread that replaces it.
+    mutable std::mutex renderDataMutex;
 };
 
 }
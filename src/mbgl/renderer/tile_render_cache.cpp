@@ -0,0 +1,113 @@
+#include <mbgl/renderer/tile_render_cache.hpp>
+#include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace mbgl {
+
+TileRenderCache::~TileRenderCache() {
+    clear();
+
+    // The cache may be destroyed while the OpenGL context isn't current on this thread.
+    if (fbo) {
+        util::ThreadContext::getGLObjectStore()->abandonFramebuffer(fbo);
+    }
+    if (depthbuffer) {
+        util::ThreadContext::getGLObjectStore()->abandonRenderbuffer(depthbuffer);
+    }
+}
+
+MemoryFootprint TileRenderCache::getMemoryFootprint() const {
+    MemoryFootprint footprint;
+    for (const auto& entry : entries) {
+        footprint.gpu += uint64_t(entry.second.width) * entry.second.height * 4;
+    }
+    // GL_DEPTH_COMPONENT16
+    footprint.gpu += uint64_t(depthbufferSize[0]) * depthbufferSize[1] * 2;
+    return footprint;
+}
+
+void TileRenderCache::setSize(size_t size_) {
+    size = size_;
+    evict(size);
+}
+
+const TileRenderCache::Texture* TileRenderCache::get(const Key& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->second;
+}
+
+const TileRenderCache::Texture& TileRenderCache::beginRender(const Key& key, uint16_t width, uint16_t height) {
+    assert(size > 0);
+    assert(index.find(key) == index.end());
+
+    // Make room for the new entry. Callers look up all tiles of a frame before rendering the
+    // missing ones, so this never evicts a texture that the current frame uses.
+    evict(size - 1);
+
+    Texture texture { 0, width, height };
+    MBGL_CHECK_ERROR(glGenTextures(1, &texture.texture));
+    MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.texture));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+    // The depth buffer is shared by all tile renders and only grows.
+    if (!depthbuffer) {
+        MBGL_CHECK_ERROR(glGenRenderbuffers(1, &depthbuffer));
+    }
+    if (depthbufferSize[0] < width || depthbufferSize[1] < height) {
+        depthbufferSize = {{ std::max(depthbufferSize[0], width), std::max(depthbufferSize[1], height) }};
+        MBGL_CHECK_ERROR(glBindRenderbuffer(GL_RENDERBUFFER, depthbuffer));
+        MBGL_CHECK_ERROR(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, depthbufferSize[0], depthbufferSize[1]));
+        MBGL_CHECK_ERROR(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    }
+
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo));
+
+    if (!fbo) {
+        MBGL_CHECK_ERROR(glGenFramebuffers(1, &fbo));
+    }
+    MBGL_CHECK_ERROR(glBindFramebuffer(GL_FRAMEBUFFER, fbo));
+    MBGL_CHECK_ERROR(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.texture, 0));
+    MBGL_CHECK_ERROR(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthbuffer));
+
+    GLenum status = MBGL_CHECK_ERROR(glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        MBGL_CHECK_ERROR(glBindFramebuffer(GL_FRAMEBUFFER, previousFbo));
+        util::ThreadContext::getGLObjectStore()->abandonTexture(texture.texture);
+        throw std::runtime_error("Couldn't create tile render cache framebuffer");
+    }
+
+    entries.emplace_front(key, texture);
+    index.emplace(key, entries.begin());
+    return entries.front().second;
+}
+
+void TileRenderCache::endRender() {
+    MBGL_CHECK_ERROR(glBindFramebuffer(GL_FRAMEBUFFER, previousFbo));
+}
+
+void TileRenderCache::clear() {
+    evict(0);
+}
+
+void TileRenderCache::evict(size_t maxEntries) {
+    while (entries.size() > maxEntries) {
+        util::ThreadContext::getGLObjectStore()->abandonTexture(entries.back().second.texture);
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+#ifndef MBGL_RENDERER_TILE_RENDER_CACHE
+#define MBGL_RENDERER_TILE_RENDER_CACHE
+
+#include <mbgl/map/memory_usage.hpp>
+#include <mbgl/map/tile_id.hpp>
+#include <mbgl/platform/gl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <list>
+#include <unordered_map>
+
+namespace mbgl {
+
+// Holds textures with the rendered non-symbol layers of individual tiles, so that consecutive
+// still images that show the same tiles at the same zoom level and with the same style can
+// composite them instead of drawing every layer again. The key includes the revision of the tile
+// data, so reloaded or reparsed tiles miss and their stale textures age out of the cache.
+class TileRenderCache : private util::noncopyable {
+public:
+    struct Key {
+        const TileID id;
+        const double zoom;
+        const std::size_t styleHash;
+        const uint64_t revision;
+
+        inline bool operator==(const Key& rhs) const {
+            return id == rhs.id && zoom == rhs.zoom && styleHash == rhs.styleHash &&
+                   revision == rhs.revision;
+        }
+
+        struct Hash {
+            std::size_t operator()(const Key& key) const {
+                std::size_t seed = TileID::Hash()(key.id);
+                seed ^= std::hash<double>()(key.zoom) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= key.styleHash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                seed ^= std::hash<uint64_t>()(key.revision) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                return seed;
+            }
+        };
+    };
+
+    struct Texture {
+        GLuint texture;
+        uint16_t width;
+        uint16_t height;
+    };
+
+    TileRenderCache(size_t size_ = 0) : size(size_) {}
+    ~TileRenderCache();
+
+    void setSize(size_t);
+    size_t getSize() const { return size; }
+
+    // Returns the texture for this key and marks it as most recently used, or nullptr.
+    const Texture* get(const Key&);
+
+    // Creates a texture for this key and binds a framebuffer that renders into it. The caller
+    // is responsible for setting the viewport and clearing the buffers.
+    const Texture& beginRender(const Key&, uint16_t width, uint16_t height);
+
+    // Restores the framebuffer that was bound before beginRender().
+    void endRender();
+
+    void clear();
+
+    // Memory held by the textures and the depth buffer.
+    MemoryFootprint getMemoryFootprint() const;
+
+private:
+    void evict(size_t maxEntries);
+
+    // Most recently used entries are at the front.
+    std::list<std::pair<Key, Texture>> entries;
+    std::unordered_map<Key, std::list<std::pair<Key, Texture>>::iterator, Key::Hash> index;
+
+    size_t size;
+
+    GLuint fbo = 0;
+    GLuint depthbuffer = 0;
+    std::array<uint16_t, 2> depthbufferSize = {{ 0, 0 }};
+    GLint previousFbo = 0;
+};
+
+}
+
+#endif
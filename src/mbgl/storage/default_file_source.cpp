@@ -11,6 +11,7 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/trace.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -98,6 +99,7 @@ void DefaultFileSource::Impl::add(Request* req) {
 
     request = &pending.emplace(resource, resource).first->second;
     request->observers.insert(req);
+    MBGL_TRACE_ASYNC_BEGIN("storage", "request", request);
 
     if (cache) {
         startCacheRequest(request);
@@ -152,6 +154,7 @@ void DefaultFileSource::Impl::cancel(Request* req) {
             if (request->realRequest) {
                 request->realRequest->cancel();
             }
+            MBGL_TRACE_ASYNC_END("storage", "request", request);
             pending.erase(request->resource);
         }
     } else {
@@ -179,6 +182,7 @@ void DefaultFileSource::Impl::notify(DefaultFileRequest* request, std::shared_pt
         cache->put(request->resource, response, hint);
     }
 
+    MBGL_TRACE_ASYNC_END("storage", "request", request);
     pending.erase(request->resource);
 }
 
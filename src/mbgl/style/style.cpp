@@ -8,10 +8,14 @@
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/style/style_parser.hpp>
 #include <mbgl/style/style_bucket.hpp>
+#include <mbgl/style/property_fallback.hpp>
 #include <mbgl/geometry/glyph_atlas.hpp>
 #include <mbgl/geometry/sprite_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/json.hpp>
+#include <mbgl/util/token.hpp>
+#include <mbgl/util/utf.hpp>
 #include <mbgl/util/uv_detail.hpp>
 #include <mbgl/platform/log.hpp>
 #include <csscolorparser/csscolorparser.hpp>
@@ -30,17 +34,29 @@ Style::Style(MapData& data_, uv_loop_t* loop)
       spriteAtlas(std::make_unique<SpriteAtlas>(512, 512, data.pixelRatio, *spriteStore)),
       lineAtlas(std::make_unique<LineAtlas>(512, 512)),
       mtx(std::make_unique<uv::rwlock>()),
-      workers(4) {
+      workerPool(data.getSharedWorkers() ? Worker::getShared() : std::make_shared<Worker>(4)),
+      workers(*workerPool) {
     glyphStore->setObserver(this);
 }
 
 void Style::setJSON(const std::string& json, const std::string&) {
+    if (util::jsonDepth(json) > util::maxJSONDepth) {
+        Log::Error(Event::ParseStyle, "Style JSON is nested too deeply");
+        return;
+    }
+
     rapidjson::Document doc;
     doc.Parse<0>((const char *const)json.c_str());
     if (doc.HasParseError()) {
         Log::Error(Event::ParseStyle, "Error parsing style JSON at %i: %s", doc.GetErrorOffset(), doc.GetParseError());
         return;
     }
+    if (!doc.IsObject()) {
+        Log::Error(Event::ParseStyle, "Style JSON must be an object");
+        return;
+    }
+
+    jsonHash = hash = std::hash<std::string>()(json);
 
     StyleParser parser;
     parser.parse(doc);
@@ -93,6 +109,11 @@ void Style::cascade(const std::vector<std::string>& classes) {
     for (const auto& layer : layers) {
         layer->setClasses(classes, now, defaultTransition);
     }
+
+    hash = jsonHash;
+    for (const auto& className : classes) {
+        hash ^= std::hash<std::string>()(className) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
 }
 
 void Style::recalculate(float z, TimePoint now) {
@@ -119,6 +140,53 @@ void Style::recalculate(float z, TimePoint now) {
     }
 }
 
+void Style::prefetchGlyphs(float z) {
+    prefetchedGlyphRanges.clear();
+
+    for (const auto& layer : layers) {
+        if (!layer->bucket || layer->bucket->type != StyleLayerType::Symbol) {
+            continue;
+        }
+
+        const StyleBucket& bucket = *layer->bucket;
+        if (bucket.visibility == VisibilityType::None || bucket.min_zoom > z || bucket.max_zoom <= z) {
+            continue;
+        }
+
+        const auto& layout = bucket.layout.properties;
+        const auto field = layout.find(PropertyKey::TextField);
+        if (field == layout.end() || !field->second.is<Function<std::string>>()) {
+            continue;
+        }
+
+        const auto font = layout.find(PropertyKey::TextFont);
+        const PropertyValue& value = font != layout.end() ? font->second : PropertyFallbackValue::Get(PropertyKey::TextFont);
+        if (!value.is<Function<std::string>>()) {
+            continue;
+        }
+        const std::string fontStack = mapbox::util::apply_visitor(FunctionEvaluator<std::string>(z), value.get<Function<std::string>>());
+        if (fontStack.empty()) {
+            continue;
+        }
+
+        // Basic Latin and Latin-1 are needed by almost every label from the tiles. The
+        // characters outside of the {tokens} are the same for every label.
+        auto& ranges = prefetchedGlyphRanges[fontStack];
+        ranges.insert(getGlyphRange(0));
+
+        const std::string text = util::replaceTokens(
+            mapbox::util::apply_visitor(FunctionEvaluator<std::string>(z), field->second.get<Function<std::string>>()),
+            [](const std::string&) { return std::string(); });
+        for (const char32_t chr : util::utf8_to_utf32::convert(text)) {
+            ranges.insert(getGlyphRange(chr));
+        }
+    }
+
+    for (const auto& pair : prefetchedGlyphRanges) {
+        glyphStore->requestGlyphRangesIfNeeded(pair.first, pair.second);
+    }
+}
+
 Source* Style::getSource(const std::string& id) const {
     const auto it = std::find_if(sources.begin(), sources.end(), [&](const auto& source) {
         return source->info.source_id == id;
@@ -137,6 +205,11 @@ bool Style::hasTransitions() const {
             return true;
         }
     }
+    for (const auto& source : sources) {
+        if (source->isFading()) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -151,6 +224,12 @@ bool Style::isLoaded() const {
         return false;
     }
 
+    for (const auto& pair : prefetchedGlyphRanges) {
+        if (!glyphStore->hasGlyphRanges(pair.first, pair.second)) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -168,6 +247,9 @@ void Style::onGlyphRangeLoaded() {
 }
 
 void Style::onGlyphRangeLoadingFailed(std::exception_ptr error) {
+    // A range that failed to load never becomes available, so don't wait for it.
+    prefetchedGlyphRanges.clear();
+
     emitResourceLoadingFailed(error);
 }
 
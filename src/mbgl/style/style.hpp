@@ -57,6 +57,12 @@ public:
     void cascade(const std::vector<std::string>&);
     void recalculate(float z, TimePoint now);
 
+    // Requests the glyph ranges that the symbol layers visible at this zoom level are going
+    // to need: Latin-1 for the labels from the tiles, and the ranges of the text in their
+    // text-field templates. They load in parallel with the tiles and the sprite instead of
+    // after the tiles were partially parsed, and isLoaded() waits for them.
+    void prefetchGlyphs(float z);
+
     void setDefaultTransitionDuration(Duration);
     bool hasTransitions() const;
 
@@ -64,6 +70,18 @@ public:
         return lastError;
     }
 
+    // Identifies the style JSON and the classes that were last cascaded. Render results of
+    // styles with equal hashes are interchangeable.
+    std::size_t getHash() const {
+        return hash;
+    }
+
+    // Identifies everything that affects the contents of buckets. This is the hash of the
+    // style JSON, which also changes with paint properties, but never misses a layout change.
+    std::size_t getLayoutHash() const {
+        return jsonHash;
+    }
+
     Source* getSource(const std::string& id) const;
 
     MapData& data;
@@ -98,16 +116,24 @@ private:
 
     bool shouldReparsePartialTiles = false;
 
+    // The glyph ranges of each font stack that prefetchGlyphs() requested.
+    std::map<std::string, std::set<GlyphRange>> prefetchedGlyphRanges;
+
     Observer* observer = nullptr;
 
     std::exception_ptr lastError;
 
+    std::size_t jsonHash = 0;
+    std::size_t hash = 0;
+
     PropertyTransition defaultTransition;
     std::unique_ptr<uv::rwlock> mtx;
     ZoomHistory zoomHistory;
 
+    std::shared_ptr<Worker> workerPool;
+
 public:
-    Worker workers;
+    Worker& workers;
 };
 
 }
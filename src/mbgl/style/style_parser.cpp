@@ -21,6 +21,13 @@ namespace mbgl {
 
 using JSVal = const rapidjson::Value&;
 
+namespace {
+
+// Layers may refer to layers that refer to other layers themselves, up to this depth.
+const std::size_t maxReferenceDepth = 32;
+
+}
+
 StyleParser::StyleParser() {
 }
 
@@ -927,10 +934,17 @@ void StyleParser::parseReference(JSVal value, util::ptr<StyleLayer> &layer) {
         return;
     }
 
+    // A layer whose reference can't be resolved is parsed again from every layer that refers
+    // to it, so long chains of references take quadratic time, besides recursing deeply.
+    if (stack.size() >= maxReferenceDepth) {
+        Log::Warning(Event::ParseStyle, "layer reference of '%s' is nested too deeply", layer->id.c_str());
+        return;
+    }
+
     // Recursively parse the referenced layer.
-    stack.push_front(layer.get());
+    stack.push_back(layer.get());
     parseLayer(it->second);
-    stack.pop_front();
+    stack.pop_back();
 
     util::ptr<StyleLayer> reference = it->second.second;
     layer->type = reference->type;
@@ -9,7 +9,7 @@
 #include <mbgl/style/style_bucket.hpp>
 
 #include <unordered_map>
-#include <forward_list>
+#include <vector>
 #include <tuple>
 
 namespace mbgl {
@@ -110,7 +110,7 @@ private:
     std::unordered_map<std::string, std::pair<JSVal, util::ptr<StyleLayer>>> layersMap;
 
     // Store a stack of layers we're parsing right now. This is to prevent reference cycles.
-    std::forward_list<StyleLayer *> stack;
+    std::vector<StyleLayer *> stack;
 
     // Base URL of the sprite image.
     std::string sprite;
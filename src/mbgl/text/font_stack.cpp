@@ -5,17 +5,37 @@
 namespace mbgl {
 
 void FontStack::insert(uint32_t id, const SDFGlyph &glyph) {
-    metrics.emplace(id, glyph.metrics);
-    bitmaps.emplace(id, glyph.bitmap);
-    sdfs.emplace(id, glyph);
+    auto& glyphs = ranges[getGlyphRange(id)];
+    if (!glyphs) {
+        glyphs = std::make_shared<Glyphs>();
+    } else if (glyphs.use_count() > 1) {
+        // Other copies of this font stack share the glyphs of the range.
+        glyphs = std::make_shared<Glyphs>(*glyphs);
+    }
+    glyphs->emplace(id, glyph);
 }
 
-const std::map<uint32_t, GlyphMetrics> &FontStack::getMetrics() const {
-    return metrics;
+const SDFGlyph* FontStack::getGlyph(uint32_t id) const {
+    const auto range = ranges.find(getGlyphRange(id));
+    if (range == ranges.end()) {
+        return nullptr;
+    }
+    const auto it = range->second->find(id);
+    return it != range->second->end() ? &it->second : nullptr;
 }
 
-const std::map<uint32_t, SDFGlyph> &FontStack::getSDFs() const {
-    return sdfs;
+MemoryFootprint FontStack::getMemoryFootprint() const {
+    // A node of a std::map holds three pointers and the color next to the value.
+    const std::size_t nodeOverhead = 4 * sizeof(void*);
+
+    MemoryFootprint footprint;
+    for (const auto& range : ranges) {
+        footprint.cpu += nodeOverhead + sizeof(range) + sizeof(Glyphs);
+        for (const auto& glyph : *range.second) {
+            footprint.cpu += nodeOverhead + sizeof(glyph) + glyph.second.bitmap.capacity();
+        }
+    }
+    return footprint;
 }
 
 const Shaping FontStack::getShaping(const std::u32string &string, const float maxWidth,
@@ -32,10 +52,9 @@ const Shaping FontStack::getShaping(const std::u32string &string, const float ma
 
     // Loop through all characters of this label and shape.
     for (uint32_t chr : string) {
-        auto metric = metrics.find(chr);
-        if (metric != metrics.end()) {
+        if (const SDFGlyph* glyph = getGlyph(chr)) {
             shaping.positionedGlyphs.emplace_back(chr, x, y);
-            x += metric->second.advance + spacing;
+            x += glyph->metrics.advance + spacing;
         }
     }
 
@@ -59,12 +78,11 @@ void align(Shaping &shaping, const float justify, const float horizontalAlign,
     }
 }
 
-void justifyLine(std::vector<PositionedGlyph> &positionedGlyphs, const std::map<uint32_t, GlyphMetrics> &metrics, uint32_t start,
+void justifyLine(std::vector<PositionedGlyph> &positionedGlyphs, const FontStack &fontStack, uint32_t start,
                  uint32_t end, float justify) {
     PositionedGlyph &glyph = positionedGlyphs[end];
-    auto metric = metrics.find(glyph.glyph);
-    if (metric != metrics.end()) {
-        const uint32_t lastAdvance = metric->second.advance;
+    if (const SDFGlyph* sdf = fontStack.getGlyph(glyph.glyph)) {
+        const uint32_t lastAdvance = sdf->metrics.advance;
         const float lineIndent = float(glyph.x + lastAdvance) * justify;
 
         for (uint32_t j = start; j <= end; j++) {
@@ -104,7 +122,7 @@ void FontStack::lineWrap(Shaping &shaping, const float lineHeight, const float m
                 }
 
                 if (justify) {
-                    justifyLine(positionedGlyphs, metrics, lineStartIndex, lastSafeBreak - 1, justify);
+                    justifyLine(positionedGlyphs, *this, lineStartIndex, lastSafeBreak - 1, justify);
                 }
 
                 lineStartIndex = lastSafeBreak + 1;
@@ -120,14 +138,14 @@ void FontStack::lineWrap(Shaping &shaping, const float lineHeight, const float m
     }
 
     const PositionedGlyph& lastPositionedGlyph = positionedGlyphs.back();
-    const auto lastGlyphMetric = metrics.find(lastPositionedGlyph.glyph);
-    assert(lastGlyphMetric != metrics.end());
-    const uint32_t lastLineLength = lastPositionedGlyph.x + lastGlyphMetric->second.advance;
+    const SDFGlyph* lastGlyph = getGlyph(lastPositionedGlyph.glyph);
+    assert(lastGlyph);
+    const uint32_t lastLineLength = lastPositionedGlyph.x + lastGlyph->metrics.advance;
     maxLineLength = std::max(maxLineLength, lastLineLength);
 
     const uint32_t height = (line + 1) * lineHeight;
 
-    justifyLine(positionedGlyphs, metrics, lineStartIndex, uint32_t(positionedGlyphs.size()) - 1, justify);
+    justifyLine(positionedGlyphs, *this, lineStartIndex, uint32_t(positionedGlyphs.size()) - 1, justify);
     align(shaping, justify, horizontalAlign, verticalAlign, maxLineLength, lineHeight, line);
 
     // Calculate the bounding box
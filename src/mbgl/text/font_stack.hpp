@@ -1,26 +1,44 @@
 #ifndef MBGL_TEXT_FONT_STACK
 #define MBGL_TEXT_FONT_STACK
 
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/vec.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
+// The glyphs of a font stack, grouped by GlyphRange. Copies of a font stack share the glyphs
+// of each range until one of them inserts into it, so a copy only costs a pointer per range.
 class FontStack {
 public:
     void insert(uint32_t id, const SDFGlyph &glyph);
-    const std::map<uint32_t, GlyphMetrics> &getMetrics() const;
-    const std::map<uint32_t, SDFGlyph> &getSDFs() const;
+
+    // Returns the glyph, or nullptr if the font stack doesn't have it.
+    const SDFGlyph* getGlyph(uint32_t id) const;
+
+    template <typename Fn>
+    void forEachGlyph(Fn fn) const {
+        for (const auto& range : ranges) {
+            for (const auto& glyph : *range.second) {
+                fn(glyph.second);
+            }
+        }
+    }
+
     const Shaping getShaping(const std::u32string &string, float maxWidth, float lineHeight,
                              float horizontalAlign, float verticalAlign, float justify,
                              float spacing, const vec2<float> &translate) const;
     void lineWrap(Shaping &shaping, float lineHeight, float maxWidth, float horizontalAlign,
                   float verticalAlign, float justify) const;
 
+    // Estimated memory held by the bitmaps and metrics of the glyphs.
+    MemoryFootprint getMemoryFootprint() const;
+
 private:
-    std::map<uint32_t, std::string> bitmaps;
-    std::map<uint32_t, GlyphMetrics> metrics;
-    std::map<uint32_t, SDFGlyph> sdfs;
+    using Glyphs = std::map<uint32_t, SDFGlyph>;
+    std::map<GlyphRange, std::shared_ptr<Glyphs>> ranges;
 };
 
 } // end namespace mbgl
@@ -61,7 +61,12 @@ void GlyphPBF::parse(FontStack &stack) {
         return;
     }
 
-    // Parse the glyph PBF
+    parseGlyphPBF(stack, data);
+
+    data.clear();
+}
+
+void parseGlyphPBF(FontStack &stack, const std::string &data) {
     pbf glyphs_pbf(reinterpret_cast<const uint8_t *>(data.data()), data.size());
 
     while (glyphs_pbf.next()) {
@@ -93,6 +98,14 @@ void GlyphPBF::parse(FontStack &stack) {
                         }
                     }
 
+                    // GlyphAtlas copies the whole bitmap, which has a 3px border around the
+                    // glyph. Skip glyphs whose bitmap doesn't have exactly that many pixels.
+                    if (!glyph.bitmap.empty() &&
+                        glyph.bitmap.size() != (uint64_t(glyph.metrics.width) + 3 * 2) *
+                                                   (uint64_t(glyph.metrics.height) + 3 * 2)) {
+                        continue;
+                    }
+
                     stack.insert(glyph.id, glyph);
                 } else {
                     fontstack_pbf.skip();
@@ -102,9 +115,9 @@ void GlyphPBF::parse(FontStack &stack) {
             glyphs_pbf.skip();
         }
     }
+}
 
-    data.clear();
-
+void GlyphPBF::markParsed() {
     parsed = true;
 }
 
@@ -24,7 +24,10 @@ public:
              const GlyphLoadingFailedCallback& failureCallback);
     ~GlyphPBF();
 
+    // Adds the glyphs to the stack. The range only counts as parsed once markParsed() is
+    // called, so that the owner can first publish the stack.
     void parse(FontStack &stack);
+    void markParsed();
     bool isParsed() const;
 
     std::string getURL() const {
@@ -44,6 +47,9 @@ private:
     Request* req = nullptr;
 };
 
+// Adds the glyphs of a glyph range PBF to the stack. Throws pbf::exception on malformed data.
+void parseGlyphPBF(FontStack &stack, const std::string &data);
+
 } // end namespace mbgl
 
 #endif
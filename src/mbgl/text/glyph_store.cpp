@@ -8,7 +8,8 @@
 namespace mbgl {
 
 GlyphStore::GlyphStore(uv_loop_t* loop)
-    : asyncEmitGlyphRangeLoaded(std::make_unique<uv::async>(loop, [this] { emitGlyphRangeLoaded(); })),
+    : stacks(std::make_shared<const FontStacks>()),
+      asyncEmitGlyphRangeLoaded(std::make_unique<uv::async>(loop, [this] { emitGlyphRangeLoaded(); })),
       asyncEmitGlyphRangeLoadedingFailed(std::make_unique<uv::async>(loop, [this] { emitGlyphRangeLoadingFailed(); })),
       observer(nullptr) {
     asyncEmitGlyphRangeLoaded->unref();
@@ -32,9 +33,8 @@ bool GlyphStore::requestGlyphRangesIfNeeded(const std::string& fontStackName,
     }
 
     auto successCallback = [this, fontStackName](GlyphPBF* glyph) {
-        auto fontStack = createFontStack(fontStackName);
         try {
-            glyph->parse(**fontStack);
+            addGlyphs(fontStackName, *glyph);
             asyncEmitGlyphRangeLoaded->send();
         } catch (const std::exception&) {
             std::lock_guard<std::mutex> lock(errorMessageMutex);
@@ -70,26 +70,57 @@ bool GlyphStore::requestGlyphRangesIfNeeded(const std::string& fontStackName,
     return requestIsNeeded;
 }
 
-util::exclusive<FontStack> GlyphStore::createFontStack(const std::string &fontStack) {
-    auto lock = std::make_unique<std::lock_guard<std::mutex>>(stacksMutex);
+bool GlyphStore::hasGlyphRanges(const std::string& fontStackName,
+                                const std::set<GlyphRange>& glyphRanges) {
+    std::lock_guard<std::mutex> lock(rangesMutex);
+    const auto rangeSets = ranges.find(fontStackName);
+    if (rangeSets == ranges.end()) {
+        return glyphRanges.empty();
+    }
 
-    auto stack_it = stacks.find(fontStack);
-    if (stack_it == stacks.end()) {
-        stack_it = stacks.emplace(fontStack, std::make_unique<FontStack>()).first;
+    for (const auto& range : glyphRanges) {
+        const auto it = rangeSets->second.find(range);
+        if (it == rangeSets->second.end() || !it->second->isParsed()) {
+            return false;
+        }
     }
 
-    return { stack_it->second.get(), std::move(lock) };
+    return true;
+}
+
+void GlyphStore::addGlyphs(const std::string &fontStack, GlyphPBF& glyph) {
+    std::lock_guard<std::mutex> lock(stacksMutex);
+
+    // The snapshot can't change while we hold the lock, so no update gets lost.
+    auto newStacks = std::make_shared<FontStacks>(*std::atomic_load(&stacks));
+    auto& stack = (*newStacks)[fontStack];
+    auto newStack = stack ? std::make_shared<FontStack>(*stack) : std::make_shared<FontStack>();
+    glyph.parse(*newStack);
+    stack = std::move(newStack);
+
+    std::atomic_store(&stacks, std::shared_ptr<const FontStacks>(std::move(newStacks)));
+
+    // Only now can workers that see the range as parsed find its glyphs.
+    glyph.markParsed();
+}
+
+MemoryFootprint GlyphStore::getMemoryFootprint() const {
+    MemoryFootprint footprint;
+    for (const auto& stack : *std::atomic_load(&stacks)) {
+        footprint += stack.second->getMemoryFootprint();
+    }
+    return footprint;
 }
 
-util::exclusive<FontStack> GlyphStore::getFontStack(const std::string &fontStack) {
-    auto lock = std::make_unique<std::lock_guard<std::mutex>>(stacksMutex);
+std::shared_ptr<const FontStack> GlyphStore::getFontStack(const std::string &fontStack) const {
+    const auto snapshot = std::atomic_load(&stacks);
 
-    const auto& stack_it = stacks.find(fontStack);
-    if (stack_it == stacks.end()) {
-        return { nullptr, nullptr };
+    const auto it = snapshot->find(fontStack);
+    if (it == snapshot->end()) {
+        return nullptr;
     }
 
-    return { stack_it->second.get(), std::move(lock) };
+    return it->second;
 }
 
 void GlyphStore::setObserver(Observer* observer_) {
@@ -1,10 +1,12 @@
 #ifndef MBGL_TEXT_GLYPH_STORE
 #define MBGL_TEXT_GLYPH_STORE
 
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/text/glyph.hpp>
 
-#include <mbgl/util/exclusive.hpp>
-
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -41,7 +43,16 @@ public:
     // GlyphRanges are already available, and thus, no request is performed.
     bool requestGlyphRangesIfNeeded(const std::string &fontStack, const std::set<GlyphRange> &glyphRanges);
 
-    util::exclusive<FontStack> getFontStack(const std::string &fontStack);
+    // Whether all of the GlyphRanges were loaded and parsed.
+    bool hasGlyphRanges(const std::string &fontStack, const std::set<GlyphRange> &glyphRanges);
+
+    // Returns the current snapshot of the font stack, or nullptr if no glyphs were loaded for
+    // it yet. Snapshots are immutable, so callers can shape text without holding a lock; glyph
+    // ranges that arrive later are published as a new snapshot.
+    std::shared_ptr<const FontStack> getFontStack(const std::string &fontStack) const;
+
+    // Memory held by the current snapshots of all font stacks.
+    MemoryFootprint getMemoryFootprint() const;
 
     void setURL(const std::string &url);
 
@@ -51,14 +62,20 @@ private:
     void emitGlyphRangeLoaded();
     void emitGlyphRangeLoadingFailed();
 
-    util::exclusive<FontStack> createFontStack(const std::string &fontStack);
+    // Copies the current snapshot of the font stack, adds the glyphs of the range and
+    // publishes the result. The copy shares the glyphs of the other ranges.
+    void addGlyphs(const std::string &fontStack, GlyphPBF&);
 
     std::string glyphURL;
 
     std::unordered_map<std::string, std::map<GlyphRange, std::unique_ptr<GlyphPBF>>> ranges;
     std::mutex rangesMutex;
 
-    std::unordered_map<std::string, std::unique_ptr<FontStack>> stacks;
+    using FontStacks = std::unordered_map<std::string, std::shared_ptr<const FontStack>>;
+
+    // Replaced as a whole with std::atomic_store() whenever a stack changes. Only writers
+    // lock stacksMutex, to serialize their updates.
+    std::shared_ptr<const FontStacks> stacks;
     std::mutex stacksMutex;
 
     std::string errorMessage;
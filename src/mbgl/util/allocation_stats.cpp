@@ -0,0 +1,125 @@
+#include <mbgl/util/allocation_stats.hpp>
+#include <mbgl/util/uv_detail.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace mbgl {
+namespace allocation {
+
+const char* tagName(Tag tag) {
+    switch (tag) {
+        case Untagged: return "untagged";
+        case Parse: return "parse";
+        case Tessellate: return "tessellate";
+        case Shape: return "shape";
+        case Place: return "place";
+        case Upload: return "upload";
+        default: return "unknown";
+    }
+}
+
+Counter Counters::total() const {
+    Counter result;
+    for (const auto& counter : tags) {
+        result.allocations += counter.allocations;
+        result.bytes += counter.bytes;
+    }
+    return result;
+}
+
+std::string toString(const Counters& counters) {
+    std::ostringstream result;
+    for (uint8_t i = 0; i < TagCount; i++) {
+        const Counter& counter = counters.tags[i];
+        if (counter.allocations) {
+            if (result.tellp() > 0) {
+                result << ", ";
+            }
+            result << tagName(Tag(i)) << ": " << counter.allocations << " (" << counter.bytes << " bytes)";
+        }
+    }
+    return result.str();
+}
+
+#ifdef MBGL_ALLOCATION_STATS
+
+namespace {
+
+uv::tls<Counters> current;
+
+// operator new also runs during static initialization and destruction, before `current` was
+// created or after it was deleted. This flag is constant initialized, so it is false then.
+bool ready = false;
+
+struct ReadyGuard {
+    ReadyGuard() { ready = true; }
+    ~ReadyGuard() { ready = false; }
+} readyGuard;
+
+}
+
+void record(std::size_t bytes) {
+    if (!ready) {
+        return;
+    }
+    if (Counters* counters = current.get()) {
+        Counter& counter = counters->tags[counters->tag];
+        counter.allocations++;
+        counter.bytes += bytes;
+    }
+}
+
+Counters* install(Counters* counters) {
+    Counters* previous = current.get();
+    current.set(counters);
+    return previous;
+}
+
+TagScope::TagScope(Tag tag)
+    : counters(current.get()),
+      previous(counters ? counters->tag : Untagged) {
+    if (counters) {
+        counters->tag = tag;
+    }
+}
+
+TagScope::~TagScope() {
+    if (counters) {
+        counters->tag = previous;
+    }
+}
+
+#else
+
+Counters* install(Counters*) {
+    return nullptr;
+}
+
+#endif
+
+}
+}
+
+#ifdef MBGL_ALLOCATION_STATS
+
+// Array and nothrow forms forward to these by default.
+void* operator new(std::size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    mbgl::allocation::record(size);
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif
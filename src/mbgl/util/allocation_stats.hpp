@@ -0,0 +1,96 @@
+#ifndef MBGL_UTIL_ALLOCATION_STATS
+#define MBGL_UTIL_ALLOCATION_STATS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace allocation {
+
+// Allocation counting is only compiled in when MBGL_ALLOCATION_STATS is defined, which the
+// ALLOCATION_STATS=1 make option does. Such builds replace the global operator new, which then
+// attributes every allocation of a thread to the Counters installed on that thread, under the
+// tag of the innermost TagScope. In regular builds, the scopes below compile to nothing.
+#ifdef MBGL_ALLOCATION_STATS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+enum Tag : uint8_t {
+    Untagged,
+    Parse,
+    Tessellate,
+    Shape,
+    Place,
+    Upload,
+    TagCount
+};
+
+const char* tagName(Tag);
+
+struct Counter {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+struct Counters {
+    std::array<Counter, TagCount> tags {{}};
+
+    // The tag that allocations are currently attributed to. Maintained by TagScope.
+    Tag tag = Untagged;
+
+    const Counter& operator[](Tag t) const { return tags[t]; }
+    Counter total() const;
+};
+
+// Lists the non-zero counters, e.g. "parse: 1200 (80400 bytes), tessellate: 300 (...)".
+std::string toString(const Counters&);
+
+// Installs counters for the current thread and returns the ones that were installed before.
+// Pass nullptr to stop counting.
+Counters* install(Counters*);
+
+// Counts an allocation that bypasses operator new, e.g. one made by a C library with malloc().
+#ifdef MBGL_ALLOCATION_STATS
+void record(std::size_t bytes);
+#else
+inline void record(std::size_t) {}
+#endif
+
+// Counts the allocations of the current thread into the counters while in scope.
+class CountScope {
+public:
+#ifdef MBGL_ALLOCATION_STATS
+    explicit CountScope(Counters& counters) : previous(install(&counters)) {}
+    ~CountScope() { install(previous); }
+
+private:
+    Counters* const previous;
+#else
+    explicit CountScope(Counters&) {}
+#endif
+};
+
+// Attributes the allocations of the current thread to the tag while in scope. Scopes nest;
+// the tag of the outer scope applies again once the inner one ends.
+class TagScope {
+public:
+#ifdef MBGL_ALLOCATION_STATS
+    explicit TagScope(Tag);
+    ~TagScope();
+
+private:
+    Counters* const counters;
+    const Tag previous;
+#else
+    explicit TagScope(Tag) {}
+#endif
+};
+
+}
+}
+
+#endif
@@ -62,7 +62,10 @@ void ClipIDGenerator::update(std::forward_list<Tile *> tiles) {
         // by z earlier, so all preceding items cannot be children of the current
         // tile.
         for (auto child_it = std::next(it); child_it != end; child_it++) {
-            clip.add((*child_it)->id);
+            // Tiles that are fading in don't cover their parents yet.
+            if (!(*child_it)->isFading()) {
+                clip.add((*child_it)->id);
+            }
         }
         clip.children.sort();
 
@@ -22,6 +22,16 @@ void GLObjectStore::abandonTexture(uint32_t texture) {
     abandonedTextures.emplace_back(texture);
 }
 
+void GLObjectStore::abandonFramebuffer(uint32_t framebuffer) {
+    assert(ThreadContext::currentlyOn(ThreadType::Map));
+    abandonedFramebuffers.emplace_back(framebuffer);
+}
+
+void GLObjectStore::abandonRenderbuffer(uint32_t renderbuffer) {
+    assert(ThreadContext::currentlyOn(ThreadType::Map));
+    abandonedRenderbuffers.emplace_back(renderbuffer);
+}
+
 void GLObjectStore::performCleanup() {
     assert(ThreadContext::currentlyOn(ThreadType::Map));
 
@@ -31,6 +41,19 @@ void GLObjectStore::performCleanup() {
         abandonedVAOs.clear();
     }
 
+    // Framebuffers are deleted before the textures and renderbuffers that are attached to them.
+    if (!abandonedFramebuffers.empty()) {
+        MBGL_CHECK_ERROR(glDeleteFramebuffers(static_cast<GLsizei>(abandonedFramebuffers.size()),
+                                              abandonedFramebuffers.data()));
+        abandonedFramebuffers.clear();
+    }
+
+    if (!abandonedRenderbuffers.empty()) {
+        MBGL_CHECK_ERROR(glDeleteRenderbuffers(static_cast<GLsizei>(abandonedRenderbuffers.size()),
+                                               abandonedRenderbuffers.data()));
+        abandonedRenderbuffers.clear();
+    }
+
     if (!abandonedTextures.empty()) {
         MBGL_CHECK_ERROR(glDeleteTextures(static_cast<GLsizei>(abandonedTextures.size()),
                                           abandonedTextures.data()));
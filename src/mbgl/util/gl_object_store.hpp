@@ -17,6 +17,8 @@ public:
     void abandonVAO(uint32_t vao);
     void abandonBuffer(uint32_t buffer);
     void abandonTexture(uint32_t texture);
+    void abandonFramebuffer(uint32_t framebuffer);
+    void abandonRenderbuffer(uint32_t renderbuffer);
 
     // Actually remove the objects we marked as abandoned with the above methods.
     // Only call this while the OpenGL context is exclusive to this thread.
@@ -26,6 +28,8 @@ private:
     std::vector<uint32_t> abandonedVAOs;
     std::vector<uint32_t> abandonedBuffers;
     std::vector<uint32_t> abandonedTextures;
+    std::vector<uint32_t> abandonedFramebuffers;
+    std::vector<uint32_t> abandonedRenderbuffers;
 };
 
 }
@@ -0,0 +1,34 @@
+#include <mbgl/util/json.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+namespace util {
+
+std::size_t jsonDepth(const std::string& json) {
+    std::size_t depth = 0;
+    std::size_t deepest = 0;
+    bool inString = false;
+    for (auto it = json.begin(); it != json.end() && *it != '\0'; ++it) {
+        const char c = *it;
+        if (inString) {
+            if (c == '\\') {
+                if (++it == json.end()) {
+                    break;
+                }
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            deepest = std::max(deepest, ++depth);
+        } else if ((c == '}' || c == ']') && depth > 0) {
+            depth--;
+        }
+    }
+    return deepest;
+}
+
+}
+}
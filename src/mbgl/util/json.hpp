@@ -0,0 +1,20 @@
+#ifndef MBGL_UTIL_JSON
+#define MBGL_UTIL_JSON
+
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// rapidjson parses objects and arrays recursively, so JSON that nests them too deeply
+// overflows the stack. JSON from the network is checked against this before it is parsed.
+const std::size_t maxJSONDepth = 256;
+
+// Returns how deeply objects and arrays are nested in the JSON text. Brackets in strings
+// don't count. The text isn't validated otherwise.
+std::size_t jsonDepth(const std::string& json);
+
+}
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include <mbgl/util/metrics_registry.hpp>
+
+namespace mbgl {
+namespace metrics {
+
+namespace {
+
+// Constant initialized, so metrics of any translation unit can register during static
+// initialization.
+std::atomic<Metric*> head { nullptr };
+
+}
+
+Gauge gpuBufferBytes("gpu.buffer_bytes");
+Gauge gpuTextureBytes("gpu.texture_bytes");
+
+Metric::Metric(const char* name_) : name(name_) {
+    next = head.load();
+    while (!head.compare_exchange_weak(next, this)) {}
+}
+
+void Counter::collect(Snapshot& snapshot) const {
+    snapshot.counters[name] += value.load(std::memory_order_relaxed);
+}
+
+void Gauge::collect(Snapshot& snapshot) const {
+    snapshot.gauges[name] += value.load(std::memory_order_relaxed);
+}
+
+constexpr std::size_t Histogram::BucketCount;
+
+Histogram::Histogram(const char* name_, uint64_t firstBound_)
+    : Metric(name_), firstBound(firstBound_) {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::record(uint64_t value) {
+    std::size_t bucket = 0;
+    for (uint64_t bound = firstBound; bucket < BucketCount - 1 && value >= bound; bound *= 2) {
+        bucket++;
+    }
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Histogram::collect(Snapshot& snapshot) const {
+    HistogramSnapshot& result = snapshot.histograms[name];
+    result.bounds.resize(BucketCount - 1);
+    result.counts.resize(BucketCount);
+
+    uint64_t bound = firstBound;
+    for (std::size_t i = 0; i < BucketCount; i++) {
+        if (i < BucketCount - 1) {
+            result.bounds[i] = bound;
+            bound *= 2;
+        }
+        const uint64_t count = counts[i].load(std::memory_order_relaxed);
+        result.counts[i] += count;
+        result.count += count;
+    }
+    result.sum += sum.load(std::memory_order_relaxed);
+}
+
+double HistogramSnapshot::mean() const {
+    return count ? double(sum) / count : 0;
+}
+
+Snapshot snapshot() {
+    Snapshot result;
+    for (const Metric* metric = head.load(); metric; metric = metric->next) {
+        metric->collect(result);
+    }
+    return result;
+}
+
+}
+}
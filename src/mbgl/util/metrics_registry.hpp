@@ -0,0 +1,90 @@
+#ifndef MBGL_UTIL_METRICS_REGISTRY
+#define MBGL_UTIL_METRICS_REGISTRY
+
+#include <mbgl/util/metrics.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+namespace metrics {
+
+// Metrics are defined as objects with static storage duration, and register themselves on
+// construction. Updating them is a relaxed atomic operation, so they may be used on hot paths
+// of any thread.
+class Metric : private util::noncopyable {
+public:
+    const char* const name;
+
+protected:
+    explicit Metric(const char* name);
+    virtual ~Metric() = default;
+
+private:
+    virtual void collect(Snapshot&) const = 0;
+
+    Metric* next = nullptr;
+    friend Snapshot snapshot();
+};
+
+class Counter : public Metric {
+public:
+    explicit Counter(const char* name_) : Metric(name_) {}
+
+    void add(uint64_t n = 1) {
+        value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+private:
+    void collect(Snapshot&) const override;
+
+    std::atomic<uint64_t> value { 0 };
+};
+
+class Gauge : public Metric {
+public:
+    explicit Gauge(const char* name_) : Metric(name_) {}
+
+    void add(int64_t n) {
+        value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void subtract(int64_t n) {
+        value.fetch_sub(n, std::memory_order_relaxed);
+    }
+
+private:
+    void collect(Snapshot&) const override;
+
+    std::atomic<int64_t> value { 0 };
+};
+
+// Counts values in exponential buckets: the first bucket holds the values below
+// `firstBound`, and every further bucket has twice the upper bound of the previous one.
+class Histogram : public Metric {
+public:
+    static constexpr std::size_t BucketCount = 16;
+
+    Histogram(const char* name, uint64_t firstBound);
+
+    void record(uint64_t value);
+
+private:
+    void collect(Snapshot&) const override;
+
+    const uint64_t firstBound;
+    std::array<std::atomic<uint64_t>, BucketCount> counts;
+    std::atomic<uint64_t> sum { 0 };
+};
+
+// GPU memory is allocated by several subsystems.
+extern Gauge gpuBufferBytes;
+extern Gauge gpuTextureBytes;
+
+}
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <string>
 #include <cstring>
+#include <vector>
 
 namespace mbgl {
 
@@ -30,6 +31,15 @@ struct pbf {
     template <typename T = uint32_t> inline T varint();
     template <typename T = uint32_t> inline T svarint();
 
+    // Decodes up to `capacity` varints from the current position, as found in packed repeated
+    // fields, and returns how many were decoded. Values are truncated to 32 bits, like
+    // varint<uint64_t>() would. Runs of single byte values are decoded eight at a time.
+    inline std::size_t packedVarints(uint32_t* out, std::size_t capacity);
+
+    // Decodes the varints from the current position to the end of the message.
+    inline void packedVarints(std::vector<uint32_t>& out);
+    static inline int32_t zigzag(uint32_t n);
+
     template <typename T = uint32_t, int bytes = 4> inline T fixed();
     inline float float32();
     inline double float64();
@@ -114,6 +124,76 @@ T pbf::svarint() {
     return (n >> 1) ^ -(T)(n & 1);
 }
 
+std::size_t pbf::packedVarints(uint32_t* out, std::size_t capacity) {
+    uint32_t* values = out;
+    uint32_t* const last = out + capacity;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint64_t high = 0x8080808080808080ULL;
+    while (end - data >= 8 && last - values >= 8) {
+        uint64_t word;
+        memcpy(&word, data, 8);
+
+        const uint64_t continued = word & high;
+        if (continued == 0) {
+            // Eight single byte varints.
+            for (int i = 0; i < 8; i++) {
+                *values++ = uint8_t(word >> (i * 8));
+            }
+            data += 8;
+            continue;
+        }
+
+        // Single byte varints up to the first byte with a continuation bit.
+        const int single = __builtin_ctzll(continued) / 8;
+        for (int i = 0; i < single; i++) {
+            *values++ = uint8_t(word >> (i * 8));
+        }
+
+        // The multi byte varint that follows, if it ends within the word.
+        const uint64_t terminators = ~word & high & (~uint64_t(0) << (single * 8));
+        if (terminators == 0) {
+            data += single;
+            *values++ = static_cast<uint32_t>(varint<uint64_t>());
+            continue;
+        }
+        const int terminator = __builtin_ctzll(terminators) / 8;
+        uint64_t x = (word >> (single * 8)) & (~uint64_t(0) >> ((7 - (terminator - single)) * 8));
+
+        // Squeeze out the continuation bits of up to eight bytes.
+        x &= 0x7F7F7F7F7F7F7F7FULL;
+        x = ((x & 0x7F007F007F007F00ULL) >> 1) | (x & 0x007F007F007F007FULL);
+        x = ((x & 0x3FFF00003FFF0000ULL) >> 2) | (x & 0x00003FFF00003FFFULL);
+        x = ((x & 0x0FFFFFFF00000000ULL) >> 4) | (x & 0x000000000FFFFFFFULL);
+        *values++ = static_cast<uint32_t>(x);
+        data += terminator + 1;
+    }
+#endif
+
+    while (data < end && values < last) {
+        *values++ = static_cast<uint32_t>(varint<uint64_t>());
+    }
+
+    return values - out;
+}
+
+void pbf::packedVarints(std::vector<uint32_t>& out) {
+    out.clear();
+
+    // A varint takes at least one byte, so this is the maximum number of values. Decoding
+    // through a small buffer avoids zero filling all of them first.
+    out.reserve(end - data);
+    uint32_t chunk[256];
+    while (data < end) {
+        const std::size_t count = packedVarints(chunk, sizeof(chunk) / sizeof(chunk[0]));
+        out.insert(out.end(), chunk, chunk + count);
+    }
+}
+
+int32_t pbf::zigzag(uint32_t n) {
+    return static_cast<int32_t>((n >> 1) ^ -(n & 1));
+}
+
 template <typename T, int bytes>
 T pbf::fixed() {
     skipBytes(bytes);
@@ -173,7 +253,8 @@ void pbf::skipValue(uint32_t val) {
 }
 
 void pbf::skipBytes(uint32_t bytes) {
-    if (data + bytes > end) {
+    // Compares lengths, since data + bytes may point far beyond the buffer.
+    if (bytes > static_cast<size_t>(end - data)) {
         throw end_of_buffer_exception();
     }
     data += bytes;
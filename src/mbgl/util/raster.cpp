@@ -1,9 +1,12 @@
+#include <mbgl/gl/stats.hpp>
 #include <mbgl/platform/platform.hpp>
 #include <mbgl/platform/gl.hpp>
 #include <mbgl/platform/log.hpp>
 
 #include <mbgl/util/raster.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/util/uv_detail.hpp>
+#include <mbgl/util/trace.hpp>
 
 #include <cassert>
 #include <cstring>
@@ -16,7 +19,8 @@ Raster::Raster(TexturePool& texturePool_)
 
 Raster::~Raster() {
     if (textured) {
-        texturePool.removeTextureID(texture);
+        texturePool.removeTextureID(texture, width * height * 4);
+        metrics::gpuTextureBytes.subtract(width * height * 4);
     }
 }
 
@@ -25,6 +29,16 @@ bool Raster::isLoaded() const {
     return loaded;
 }
 
+MemoryFootprint Raster::getMemoryFootprint() const {
+    // The image is loaded on a worker thread. Its dimensions are safe to read once it is.
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!loaded) {
+        return {};
+    }
+    const uint64_t bytes = uint64_t(width) * height * 4;
+    return { textured ? 0 : bytes, textured ? bytes : 0 };
+}
+
 bool Raster::load(std::unique_ptr<util::Image> image) {
     img = std::move(image);
     width = img->getWidth();
@@ -60,6 +74,7 @@ void Raster::bind(bool linear) {
 
 void Raster::upload() {
     if (img && !textured) {
+        MBGL_TRACE_SCOPE("gl", "raster upload");
         texture = texturePool.getTextureID();
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture));
 #ifndef GL_ES_VERSION_2_0
@@ -68,6 +83,8 @@ void Raster::upload() {
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, img->getData()));
+        gl::stats::upload(width * height * 4);
+        metrics::gpuTextureBytes.add(width * height * 4);
         img.reset();
         textured = true;
     }
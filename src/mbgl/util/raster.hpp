@@ -1,6 +1,7 @@
 #ifndef MBGL_UTIL_RASTER
 #define MBGL_UTIL_RASTER
 
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/util/texture_pool.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/ptr.hpp>
@@ -30,6 +31,9 @@ public:
     // loaded status
     bool isLoaded() const;
 
+    // Memory held by the pixels that wait for upload, and by the texture.
+    MemoryFootprint getMemoryFootprint() const;
+
 public:
     // loaded image dimensions
     uint32_t width = 0, height = 0;
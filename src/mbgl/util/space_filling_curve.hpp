@@ -0,0 +1,85 @@
+#ifndef MBGL_UTIL_SPACE_FILLING_CURVE
+#define MBGL_UTIL_SPACE_FILLING_CURVE
+
+#include <cstdint>
+#include <utility>
+
+namespace mbgl {
+namespace util {
+
+// Spreads the lower 32 bits of x so that there is a zero bit between every two bits.
+inline uint64_t mortonSpread(uint64_t x) {
+    x &= 0xFFFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2))  & 0x3333333333333333ULL;
+    x = (x | (x << 1))  & 0x5555555555555555ULL;
+    return x;
+}
+
+// Inverse of mortonSpread(); drops every odd bit.
+inline uint32_t mortonCompact(uint64_t x) {
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >> 1))  & 0x3333333333333333ULL;
+    x = (x | (x >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >> 4))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >> 8))  & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return uint32_t(x);
+}
+
+// Interleaves x and y into a Z-order index. The four children of the tile (x, y) at the next
+// zoom level have the indices mortonEncode(x, y) * 4 + [0, 4).
+inline uint64_t mortonEncode(uint32_t x, uint32_t y) {
+    return mortonSpread(x) | (mortonSpread(y) << 1);
+}
+
+inline std::pair<uint32_t, uint32_t> mortonDecode(uint64_t index) {
+    return { mortonCompact(index), mortonCompact(index >> 1) };
+}
+
+// Returns the position of (x, y) along the Hilbert curve that fills a 2^z * 2^z grid. Unlike
+// the Morton order, consecutive indices are always adjacent tiles, which makes it the better
+// order for requests that should hit neighbouring data.
+inline uint64_t hilbertEncode(uint8_t z, uint32_t x, uint32_t y) {
+    uint64_t index = 0;
+    for (uint32_t s = z ? (uint32_t(1) << (z - 1)) : 0; s > 0; s >>= 1) {
+        const uint32_t rx = (x & s) > 0;
+        const uint32_t ry = (y & s) > 0;
+        index += uint64_t(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+inline std::pair<uint32_t, uint32_t> hilbertDecode(uint8_t z, uint64_t index) {
+    uint32_t x = 0, y = 0;
+    const uint32_t n = uint32_t(1) << z;
+    for (uint32_t s = 1; s < n; s <<= 1) {
+        const uint32_t rx = 1 & (index / 2);
+        const uint32_t ry = 1 & (index ^ rx);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+        x += s * rx;
+        y += s * ry;
+        index /= 4;
+    }
+    return { x, y };
+}
+
+} // namespace util
+} // namespace mbgl
+
+#endif
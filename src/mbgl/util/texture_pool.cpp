@@ -1,6 +1,7 @@
 #include <mbgl/util/texture_pool.hpp>
 
 #include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 #include <mbgl/util/thread_context.hpp>
 
 #include <vector>
@@ -9,30 +10,50 @@ const int TextureMax = 64;
 
 using namespace mbgl;
 
+namespace {
+
+metrics::Gauge pooledTextures("texture_pool.free_textures");
+metrics::Gauge usedTextures("texture_pool.used_textures");
+
+}
+
+TexturePool::~TexturePool() {
+    pooledTextures.subtract(texture_ids.size());
+}
+
 GLuint TexturePool::getTextureID() {
     if (texture_ids.empty()) {
         GLuint new_texture_ids[TextureMax];
         MBGL_CHECK_ERROR(glGenTextures(TextureMax, new_texture_ids));
         for (uint32_t id = 0; id < TextureMax; id++) {
-            texture_ids.insert(new_texture_ids[id]);
+            texture_ids.emplace(new_texture_ids[id], 0);
         }
+        pooledTextures.add(TextureMax);
     }
 
     GLuint id = 0;
 
     if (!texture_ids.empty()) {
-        std::set<GLuint>::iterator id_iterator = texture_ids.begin();
-        id = *id_iterator;
+        auto id_iterator = texture_ids.begin();
+        id = id_iterator->first;
+        // The storage is replaced by the next upload.
+        retainedBytes -= id_iterator->second;
         texture_ids.erase(id_iterator);
+        pooledTextures.subtract(1);
+        usedTextures.add(1);
     }
 
     return id;
 }
 
-void TexturePool::removeTextureID(GLuint texture_id) {
+void TexturePool::removeTextureID(GLuint texture_id, uint64_t bytes) {
     bool needs_clear = false;
 
-    texture_ids.insert(texture_id);
+    if (texture_ids.emplace(texture_id, bytes).second) {
+        pooledTextures.add(1);
+        retainedBytes += bytes;
+    }
+    usedTextures.subtract(1);
 
     if (texture_ids.size() > TextureMax) {
         needs_clear = true;
@@ -46,8 +67,14 @@ void TexturePool::removeTextureID(GLuint texture_id) {
 
 void TexturePool::clearTextureIDs() {
     auto getGLObjectStore = util::ThreadContext::getGLObjectStore();
-    for (auto texture : texture_ids) {
-        getGLObjectStore->abandonTexture(texture);
+    for (const auto& texture : texture_ids) {
+        getGLObjectStore->abandonTexture(texture.first);
     }
+    pooledTextures.subtract(texture_ids.size());
     texture_ids.clear();
+    retainedBytes = 0;
+}
+
+MemoryFootprint TexturePool::getMemoryFootprint() const {
+    return { 0, retainedBytes };
 }
@@ -1,10 +1,11 @@
 #ifndef MBGL_UTIL_TEXTUREPOOL
 #define MBGL_UTIL_TEXTUREPOOL
 
+#include <mbgl/map/memory_usage.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/platform/gl.hpp>
 
-#include <set>
+#include <map>
 #include <mutex>
 
 namespace mbgl {
@@ -12,12 +13,20 @@ namespace mbgl {
 class TexturePool : private util::noncopyable {
 
 public:
+    ~TexturePool();
+
     GLuint getTextureID();
-    void removeTextureID(GLuint texture_id);
+    // Returns a texture to the pool. It keeps its `bytes` of storage until it is reused.
+    void removeTextureID(GLuint texture_id, uint64_t bytes = 0);
     void clearTextureIDs();
 
+    // Memory held by the textures in the pool.
+    MemoryFootprint getMemoryFootprint() const;
+
 private:
-    std::set<GLuint> texture_ids;
+    // Maps the textures in the pool to the size of their storage.
+    std::map<GLuint, uint64_t> texture_ids;
+    uint64_t retainedBytes = 0;
 };
 
 }
@@ -31,6 +31,11 @@ struct ThreadContext {
 public:
     ThreadContext(const std::string& name, ThreadType type, ThreadPriority priority);
 
+    // Threads that weren't started by util::Thread, e.g. those of system libraries, have no context.
+    static bool hasCurrent() {
+        return current.get() != nullptr;
+    }
+
     static bool currentlyOn(ThreadType type) {
         return current.get()->type == type;
     }
@@ -2,6 +2,9 @@
 #include <mbgl/util/vec.hpp>
 #include <mbgl/util/box.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 
 // Taken from polymaps src/Layer.js
@@ -23,10 +26,9 @@ struct edge {
     }
 };
 
-typedef const std::function<void(int32_t x0, int32_t x1, int32_t y)> ScanLine;
-
-// scan-line conversion
-static void scanSpans(edge e0, edge e1, int32_t ymin, int32_t ymax, ScanLine scanLine) {
+// scan-line conversion; calls scanLine(x0, x1, y) for every row
+template <typename ScanLine>
+static void scanSpans(edge e0, edge e1, int32_t ymin, int32_t ymax, ScanLine& scanLine) {
     double y0 = std::fmax(ymin, std::floor(e1.y0));
     double y1 = std::fmin(ymax, std::ceil(e1.y1));
 
@@ -50,6 +52,7 @@ static void scanSpans(edge e0, edge e1, int32_t ymin, int32_t ymax, ScanLine sca
 }
 
 // scan-line conversion
+template <typename ScanLine>
 static void scanTriangle(const mbgl::vec2<double> a, const mbgl::vec2<double> b, const mbgl::vec2<double> c, int32_t ymin, int32_t ymax, ScanLine& scanLine) {
     edge ab = edge(a, b);
     edge bc = edge(b, c);
@@ -65,15 +68,19 @@ static void scanTriangle(const mbgl::vec2<double> a, const mbgl::vec2<double> b,
     if (bc.dy) scanSpans(ca, bc, ymin, ymax, scanLine);
 }
 
-std::forward_list<TileID> tileCover(int8_t z, const mbgl::box &bounds, int8_t actualZ) {
+void tileCover(int8_t z, const mbgl::box &bounds, std::vector<CoveredTile>& t) {
     int32_t tiles = 1 << z;
-    std::forward_list<mbgl::TileID> t;
+    t.clear();
 
+    const vec2<double>& center = bounds.center;
     auto scanLine = [&](int32_t x0, int32_t x1, int32_t y) {
         int32_t x;
-        if (y >= 0 && y <= tiles) {
+        // Rows are 0 to tiles - 1. scanSpans() clamps the rows it reports to [0, tiles), so the
+        // old check for y <= tiles never let row tiles through either; this states the real range.
+        if (y >= 0 && y < tiles) {
+            const double dy = std::fabs(y - center.y);
             for (x = x0; x < x1; x++) {
-                t.emplace_front(actualZ, x, y, z);
+                t.push_back({ x, y, std::fabs(x - center.x) + dy });
             }
         }
     };
@@ -85,9 +92,114 @@ std::forward_list<TileID> tileCover(int8_t z, const mbgl::box &bounds, int8_t ac
     scanTriangle(bounds.tl, bounds.tr, bounds.br, 0, tiles, scanLine);
     scanTriangle(bounds.br, bounds.bl, bounds.tl, 0, tiles, scanLine);
 
-    t.unique();
+    // Sort by distance from the center. Both triangles share the diagonal, so rows along it
+    // can be reported twice; the tie breakers put those duplicates next to each other.
+    std::sort(t.begin(), t.end(), [](const CoveredTile& a, const CoveredTile& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.y != b.y) return a.y < b.y;
+        return a.x < b.x;
+    });
+    t.erase(std::unique(t.begin(), t.end(), [](const CoveredTile& a, const CoveredTile& b) {
+        return a.x == b.x && a.y == b.y;
+    }), t.end());
+}
+
+namespace {
+
+// Distance in tiles between a tile's center and the focus center below which the tile counts as
+// the one the focus is on. Half a tile covers the tile that contains the focus center whenever
+// that center is near its middle. This tile should keep its detail, so the focus region isn't
+// shrunk any further just to lower it.
+const double focusTileDistance = 0.5;
+
+// The ancestor `drop` levels above a tile of the cover. Overscaled tiles keep their coordinates
+// while they're lowered down to the source's maximum zoom level; below it, they move to the
+// parent's coordinates.
+TileID lowerTile(const CoveredTile& tile, int32_t drop, int32_t z, int32_t idZ) {
+    const int32_t targetZ = idZ - drop;
+    const int32_t shift = std::max(0, z - targetZ);
+    return TileID { int8_t(targetZ), tile.x >> shift, tile.y >> shift, int8_t(std::min(targetZ, z)) };
+}
+
+}
+
+void LODCover::build(const std::vector<CoveredTile>& cover, const vec2<double>& center, double radius,
+                     std::size_t budget, int32_t maxDrop, int32_t z, int32_t idZ,
+                     std::vector<TileID>& ids) {
+    while (true) {
+        const bool allDropped = build(cover, center, radius, maxDrop, z, idZ, ids);
+        if (!budget || ids.size() <= budget || allDropped) {
+            return;
+        }
+        // Shrink the focus region until the cover fits into the budget.
+        radius /= 2;
+    }
+}
+
+bool LODCover::build(const std::vector<CoveredTile>& cover, const vec2<double>& center, double radius,
+                     int32_t maxDrop, int32_t z, int32_t idZ, std::vector<TileID>& ids) {
+    // Whether every tile outside of the focus region wants to be lowered as far as allowed, i.e.
+    // whether shrinking the region further can't reduce the number of tiles anymore.
+    bool allDropped = true;
+
+    wantedDrops.clear();
+    int32_t largestDrop = 0;
+    for (const auto& tile : cover) {
+        const double distance = std::sqrt(std::pow(tile.x + 0.5 - center.x, 2) +
+                                          std::pow(tile.y + 0.5 - center.y, 2));
+        int32_t drop = 0;
+        if (radius <= 0) {
+            drop = maxDrop;
+        } else if (distance > radius) {
+            drop = std::min<int32_t>(maxDrop, std::floor(std::log2(distance / radius)) + 1);
+        }
+        if (drop < maxDrop && distance > focusTileDistance) {
+            allDropped = false;
+        }
+        wantedDrops.push_back(drop);
+        largestDrop = std::max(largestDrop, drop);
+    }
+
+    // A tile is lowered only if no tile of the cover inside the lower tile keeps more detail.
+    // Otherwise the two would overlap, and their symbols would be placed twice. If a lower tile
+    // can't be used, no tile below it can either, so each level only raises the drops found so far.
+    drops.assign(cover.size(), 0);
+    for (int32_t drop = 1; drop <= largestDrop; drop++) {
+        lowered.clear();
+        for (std::size_t i = 0; i < cover.size(); i++) {
+            lowered.emplace_back(lowerTile(cover[i], drop, z, idZ).key(), i);
+        }
+        std::sort(lowered.begin(), lowered.end());
+
+        for (auto begin = lowered.begin(); begin != lowered.end();) {
+            const uint64_t key = begin->first;
+            const auto end = std::find_if(begin, lowered.end(), [key](const std::pair<uint64_t, std::size_t>& entry) {
+                return entry.first != key;
+            });
+            const bool lower = std::all_of(begin, end, [this, drop](const std::pair<uint64_t, std::size_t>& entry) {
+                return wantedDrops[entry.second] >= drop;
+            });
+            if (lower) {
+                for (auto it = begin; it != end; ++it) {
+                    drops[it->second] = drop;
+                }
+            }
+            begin = end;
+        }
+    }
+
+    // The cover is sorted by distance, so lower tiles keep the priority of the closest tile
+    // they replace.
+    ids.clear();
+    keys.clear();
+    for (std::size_t i = 0; i < cover.size(); i++) {
+        const TileID id = lowerTile(cover[i], drops[i], z, idZ);
+        if (keys.insert(id.key())) {
+            ids.push_back(id);
+        }
+    }
 
-    return t;
+    return allDropped;
 }
 
 }
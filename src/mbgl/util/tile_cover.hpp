@@ -2,13 +2,58 @@
 #define MBGL_UTIL_TILE_COVER
 
 #include <mbgl/map/tile_id.hpp>
+#include <mbgl/map/tile_key_set.hpp>
 #include <mbgl/util/box.hpp>
+#include <mbgl/util/noncopyable.hpp>
 
-#include <forward_list>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
-std::forward_list<TileID> tileCover(int8_t z, const box& bounds, int8_t actualZ);
+// A tile of a cover, in the coordinates of the zoom level the cover was computed for.
+struct CoveredTile {
+    int32_t x;
+    int32_t y;
+
+    // Distance from the center of the covered area in tiles. Tiles closer to the center are
+    // more important and come first in a cover.
+    double distance;
+};
+
+// Replaces the contents of `tiles` with all tiles at zoom level z that intersect the bounds,
+// sorted by distance from their center. The storage of the vector is reused.
+void tileCover(int8_t z, const box& bounds, std::vector<CoveredTile>& tiles);
+
+// Lowers the tiles of a cover that are far from its center to coarser zoom levels. Its
+// scratch storage is kept between calls, so covers that are rebuilt every frame don't allocate.
+class LODCover : private util::noncopyable {
+public:
+    // Replaces `ids` with the tiles of `cover`, in the same order. Tiles farther than `radius`
+    // tiles from `center` are lowered by one zoom level for every doubling of the distance, by
+    // at most maxDrop levels. A tile is only lowered as far as all tiles of the cover inside the
+    // lower tile are, so no two tiles of the result overlap and every tile of the cover is
+    // covered exactly once.
+    //
+    // If the result has more than `budget` tiles, the radius is halved until it fits or no tile
+    // can be lowered any further. A budget of zero is unlimited.
+    //
+    // z is the zoom level of the cover and idZ the zoom level of the resulting IDs, which is
+    // larger for overscaled tiles.
+    void build(const std::vector<CoveredTile>& cover, const vec2<double>& center, double radius,
+               std::size_t budget, int32_t maxDrop, int32_t z, int32_t idZ,
+               std::vector<TileID>& ids);
+
+private:
+    // Builds the cover for one radius. Returns whether no tile can be lowered any further.
+    bool build(const std::vector<CoveredTile>& cover, const vec2<double>& center, double radius,
+               int32_t maxDrop, int32_t z, int32_t idZ, std::vector<TileID>& ids);
+
+    std::vector<int32_t> wantedDrops;
+    std::vector<int32_t> drops;
+    std::vector<std::pair<uint64_t, std::size_t>> lowered;
+    TileKeySet keys;
+};
 
 }
 
@@ -0,0 +1,287 @@
+#include <mbgl/util/trace.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> recording { false };
+
+uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+namespace {
+
+// Written by its own thread only, without locking. The registry quiesces the writers before it
+// resizes or frees the events, and exports read them like a sequence lock: events that the
+// thread overwrote while they were copied are dropped.
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string name;
+
+    std::unique_ptr<Event[]> events;
+    std::size_t capacity = 0;
+    std::atomic<uint64_t> written { 0 };
+
+    // Set by the thread while it records an event.
+    std::atomic<bool> writing { false };
+
+    // Set when the thread exited, so that the buffer can be given to the next new thread.
+    std::atomic<bool> exited { false };
+
+    // The events that stop() kept, once the ring buffer is freed.
+    std::vector<Event> stopped;
+
+    void allocate(std::size_t capacity_) {
+        if (capacity != capacity_) {
+            events.reset(capacity_ ? new Event[capacity_] : nullptr);
+            capacity = capacity_;
+        }
+        written = 0;
+        stopped.clear();
+    }
+
+    // Returns the events from oldest to newest. `concurrent` is set when the thread may be
+    // recording at the same time.
+    std::vector<Event> ordered(bool concurrent) const {
+        if (!capacity) {
+            return stopped;
+        }
+
+        const uint64_t end = written.load(std::memory_order_acquire);
+        const uint64_t begin = end > capacity ? end - capacity : 0;
+        std::vector<Event> result;
+        result.reserve(end - begin);
+        for (uint64_t i = begin; i < end; i++) {
+            result.push_back(events[i % capacity]);
+        }
+
+        if (!concurrent) {
+            return result;
+        }
+
+        // While `written` is n, the thread may be overwriting the event n - capacity.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = written.load(std::memory_order_relaxed);
+        if (after + 1 > begin + capacity) {
+            const uint64_t overwritten = std::min<uint64_t>(after + 1 - capacity - begin, result.size());
+            result.erase(result.begin(), result.begin() + overwritten);
+        }
+        return result;
+    }
+};
+
+// Buffers outlive their threads, so that events of threads that already exited are exported.
+// They are reused by new threads, and freed by the next start().
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::size_t capacity = 0;
+    uint32_t nextTid = 1;
+
+    // Stops recording and waits for the threads that are recording an event right now. With
+    // both sides sequentially consistent, a thread either sees that recording stopped, or is
+    // seen writing.
+    void quiesce() {
+        detail::recording = false;
+        for (const auto& buffer : buffers) {
+            while (buffer->writing) {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+// Never destroyed, since threads may still exit after static destruction began.
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+pthread_key_t& currentBuffer() {
+    // Like ClassDictionary, this uses the pthread functions directly, since uv::tls can't run
+    // a destructor when a thread exits.
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    static pthread_key_t key;
+    pthread_once(&once, [] {
+        pthread_key_create(&key, [](void* buffer) {
+            reinterpret_cast<ThreadBuffer*>(buffer)->exited = true;
+        });
+    });
+    return key;
+}
+
+ThreadBuffer* createBuffer() {
+    std::string name = util::ThreadContext::hasCurrent() ? util::ThreadContext::getName() : "Thread";
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    ThreadBuffer* buffer = nullptr;
+    for (const auto& candidate : reg.buffers) {
+        // Keeps the events of exited threads that stop() kept until the next start().
+        if (reg.capacity && candidate->exited) {
+            buffer = candidate.get();
+            break;
+        }
+    }
+    if (!buffer) {
+        reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer = reg.buffers.back().get();
+    }
+
+    buffer->tid = reg.nextTid++;
+    buffer->name = std::move(name);
+    buffer->allocate(reg.capacity);
+    buffer->exited = false;
+
+    pthread_setspecific(currentBuffer(), buffer);
+    return buffer;
+}
+
+void writeEvent(rapidjson::Writer<rapidjson::StringBuffer>& writer, const Event& event, uint32_t tid) {
+    const char phase[2] = { char(event.phase), 0 };
+
+    writer.StartObject();
+    writer.String("name");
+    writer.String(event.name);
+    writer.String("cat");
+    writer.String(event.category);
+    writer.String("ph");
+    writer.String(phase);
+    writer.String("ts");
+    writer.Double(event.timestamp / 1000.0);
+    writer.String("pid");
+    writer.Uint(1);
+    writer.String("tid");
+    writer.Uint(tid);
+
+    if (event.phase == Phase::Complete) {
+        writer.String("dur");
+        writer.Double(event.duration / 1000.0);
+    } else if (event.phase == Phase::Instant) {
+        writer.String("s");
+        writer.String("t");
+    } else {
+        char id[24];
+        std::snprintf(id, sizeof(id), "0x%llx", static_cast<unsigned long long>(event.id));
+        writer.String("id");
+        writer.String(id);
+    }
+
+    writer.EndObject();
+}
+
+}
+
+namespace detail {
+
+void record(const Event& event) {
+    ThreadBuffer* buffer = reinterpret_cast<ThreadBuffer*>(pthread_getspecific(currentBuffer()));
+    if (!buffer) {
+        buffer = createBuffer();
+    }
+
+    buffer->writing = true;
+    if (recording && buffer->capacity) {
+        const uint64_t n = buffer->written.load(std::memory_order_relaxed);
+        // Orders the event after the previous `written`, for exports that run at the same time.
+        std::atomic_thread_fence(std::memory_order_release);
+        buffer->events[n % buffer->capacity] = event;
+        buffer->written.store(n + 1, std::memory_order_release);
+    }
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+}
+
+void start(std::size_t eventsPerThread) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.quiesce();
+
+    reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(), [](const std::unique_ptr<ThreadBuffer>& buffer) {
+        return bool(buffer->exited);
+    }), reg.buffers.end());
+    for (const auto& buffer : reg.buffers) {
+        buffer->allocate(eventsPerThread);
+    }
+    reg.capacity = eventsPerThread;
+
+    detail::recording = true;
+}
+
+void stop() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.quiesce();
+
+    // Keeps only the recorded events, and frees the ring buffers.
+    for (const auto& buffer : reg.buffers) {
+        std::vector<Event> events = buffer->ordered(false);
+        buffer->allocate(0);
+        buffer->stopped = std::move(events);
+    }
+    reg.capacity = 0;
+}
+
+std::string exportChromeTrace() {
+    // Threads only take the lock for their first event.
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    rapidjson::StringBuffer output;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(output);
+
+    writer.StartObject();
+    writer.String("traceEvents");
+    writer.StartArray();
+    for (const auto& buffer : reg.buffers) {
+        writer.StartObject();
+        writer.String("name");
+        writer.String("thread_name");
+        writer.String("ph");
+        writer.String("M");
+        writer.String("pid");
+        writer.Uint(1);
+        writer.String("tid");
+        writer.Uint(buffer->tid);
+        writer.String("args");
+        writer.StartObject();
+        writer.String("name");
+        writer.String(buffer->name.c_str(), buffer->name.size());
+        writer.EndObject();
+        writer.EndObject();
+
+        for (const auto& event : buffer->ordered(detail::recording)) {
+            writeEvent(writer, event, buffer->tid);
+        }
+    }
+    writer.EndArray();
+    writer.String("displayTimeUnit");
+    writer.String("ms");
+    writer.EndObject();
+
+    return { output.GetString(), output.Size() };
+}
+
+}
+}
@@ -4,14 +4,59 @@
 #include <mbgl/platform/platform.hpp>
 #include <mbgl/map/vector_tile.hpp>
 #include <mbgl/map/live_tile.hpp>
-#include <mbgl/util/pbf.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/metrics_registry.hpp>
 
 #include <cassert>
 #include <future>
+#include <mutex>
 
 namespace mbgl {
 
+namespace {
+
+metrics::Gauge queueDepth("worker.queue_depth");
+metrics::Histogram queueTime("worker.queue_time_us", 100);
+metrics::Histogram parseTime("worker.parse_time_us", 500);
+
+uint64_t microsecondsSince(TimePoint start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+// Passed along with every task to keep track of the tasks that wait for a worker thread. A
+// task stops waiting once it starts, or once it is canceled and the request is released.
+class QueuedTask {
+public:
+    QueuedTask() : queued(Clock::now()) {
+        queueDepth.add(1);
+    }
+
+    QueuedTask(QueuedTask&& other) : queued(other.queued), waiting(other.waiting) {
+        other.waiting = false;
+    }
+
+    ~QueuedTask() {
+        if (waiting) {
+            queueDepth.subtract(1);
+        }
+    }
+
+    void start() {
+        if (waiting) {
+            waiting = false;
+            queueDepth.subtract(1);
+            queueTime.record(microsecondsSince(queued));
+        }
+    }
+
+private:
+    const TimePoint queued;
+    bool waiting = true;
+};
+
+}
+
 class Worker::Impl {
 public:
     Impl(FileSource* fs) {
@@ -20,7 +65,8 @@ public:
         util::ThreadContext::setFileSource(fs);
     }
 
-    void parseRasterTile(RasterBucket* bucket, std::string data, std::function<void (TileParseResult)> callback) {
+    void parseRasterTile(QueuedTask task, RasterBucket* bucket, std::string data, std::function<void (TileParseResult)> callback) {
+        task.start();
         std::unique_ptr<util::Image> image(new util::Image(data));
         if (!(*image)) {
             callback(TileParseResult("error parsing raster image"));
@@ -33,24 +79,33 @@ public:
         callback(TileParseResult(TileData::State::parsed));
     }
 
-    void parseVectorTile(TileWorker* worker, std::string data, std::function<void (TileParseResult)> callback) {
+    void parseVectorTile(QueuedTask task, TileWorker* worker, std::shared_ptr<const SharedVectorTile> tile, std::function<void (TileParseResult)> callback) {
+        task.start();
+        const TimePoint start = Clock::now();
         try {
-            pbf tilePBF(reinterpret_cast<const unsigned char *>(data.data()), data.size());
-            callback(worker->parse(VectorTile(tilePBF)));
+            const auto decoded = tile->get();
+            auto result = worker->parse(*decoded, tile->getDataHash());
+            parseTime.record(microsecondsSince(start));
+            callback(std::move(result));
         } catch (const std::exception& ex) {
             callback(TileParseResult(ex.what()));
         }
     }
 
-    void parseLiveTile(TileWorker* worker, const LiveTile* tile, std::function<void (TileParseResult)> callback) {
+    void parseLiveTile(QueuedTask task, TileWorker* worker, const LiveTile* tile, std::function<void (TileParseResult)> callback) {
+        task.start();
+        const TimePoint start = Clock::now();
         try {
-            callback(worker->parse(*tile));
+            auto result = worker->parse(*tile);
+            parseTime.record(microsecondsSince(start));
+            callback(std::move(result));
         } catch (const std::exception& ex) {
             callback(TileParseResult(ex.what()));
         }
     }
 
-    void redoPlacement(TileWorker* worker, float angle, bool collisionDebug, std::function<void ()> callback) {
+    void redoPlacement(QueuedTask task, TileWorker* worker, float angle, bool collisionDebug, std::function<void ()> callback) {
+        task.start();
         worker->redoPlacement(angle, collisionDebug);
         callback();
     }
@@ -65,24 +120,37 @@ Worker::Worker(std::size_t count) {
 
 Worker::~Worker() = default;
 
+std::shared_ptr<Worker> Worker::getShared() {
+    static std::mutex mtx;
+    static std::weak_ptr<Worker> shared;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto worker = shared.lock();
+    if (!worker) {
+        worker = std::make_shared<Worker>(4);
+        shared = worker;
+    }
+    return worker;
+}
+
+util::Thread<Worker::Impl>& Worker::nextThread() {
+    return *threads[current++ % threads.size()];
+}
+
 std::unique_ptr<WorkRequest> Worker::parseRasterTile(RasterBucket& bucket, std::string data, std::function<void (TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseRasterTile, callback, &bucket, data);
+    return nextThread().invokeWithCallback(&Worker::Impl::parseRasterTile, callback, QueuedTask(), &bucket, data);
 }
 
-std::unique_ptr<WorkRequest> Worker::parseVectorTile(TileWorker& worker, std::string data, std::function<void (TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseVectorTile, callback, &worker, data);
+std::unique_ptr<WorkRequest> Worker::parseVectorTile(TileWorker& worker, std::shared_ptr<const SharedVectorTile> tile, std::function<void (TileParseResult)> callback) {
+    return nextThread().invokeWithCallback(&Worker::Impl::parseVectorTile, callback, QueuedTask(), &worker, tile);
 }
 
 std::unique_ptr<WorkRequest> Worker::parseLiveTile(TileWorker& worker, const LiveTile& tile, std::function<void (TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseLiveTile, callback, &worker, &tile);
+    return nextThread().invokeWithCallback(&Worker::Impl::parseLiveTile, callback, QueuedTask(), &worker, &tile);
 }
 
 std::unique_ptr<WorkRequest> Worker::redoPlacement(TileWorker& worker, float angle, bool collisionDebug, std::function<void ()> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::redoPlacement, callback, &worker, angle, collisionDebug);
+    return nextThread().invokeWithCallback(&Worker::Impl::redoPlacement, callback, QueuedTask(), &worker, angle, collisionDebug);
 }
 
 } // end namespace mbgl
@@ -5,6 +5,7 @@
 #include <mbgl/util/thread.hpp>
 #include <mbgl/map/tile_worker.hpp>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 
@@ -13,12 +14,18 @@ namespace mbgl {
 class WorkRequest;
 class RasterBucket;
 class LiveTile;
+class SharedVectorTile;
 
 class Worker : public mbgl::util::noncopyable {
 public:
     Worker(std::size_t count);
     ~Worker();
 
+    // Returns the pool that is shared by all Maps that opted into shared workers. It is
+    // created on first use with the FileSource of the calling thread, and destroyed once the
+    // last Style that uses it goes away.
+    static std::shared_ptr<Worker> getShared();
+
     // Request work be done on a thread pool. Callbacks are executed on the invoking
     // thread, which must have a run loop, after the work is complete.
     //
@@ -38,7 +45,7 @@ public:
 
     Request parseVectorTile(
         TileWorker&,
-        std::string data,
+        std::shared_ptr<const SharedVectorTile>,
         std::function<void (TileParseResult)> callback);
 
     Request parseLiveTile(
@@ -54,8 +61,12 @@ public:
 
 private:
     class Impl;
+    util::Thread<Impl>& nextThread();
+
     std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
-    std::size_t current = 0;
+
+    // Requests may come from the threads of several Maps when the pool is shared.
+    std::atomic<std::size_t> current { 0 };
 };
 
 }
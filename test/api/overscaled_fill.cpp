@@ -0,0 +1,50 @@
+#include "../fixtures/util.hpp"
+#include "../fixtures/fixture_log_observer.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/still_image.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <future>
+
+TEST(API, OverscaledFill) {
+    using namespace mbgl;
+
+    // The source only has a tile at z0, so the tiles at z3 are overscaled and render the fill
+    // buckets of the z0 tile.
+    const auto style = util::read_file("test/fixtures/api/overscaled_water.json");
+
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1, 256, 256);
+    DefaultFileSource fileSource(nullptr);
+
+    Log::setObserver(std::make_unique<FixtureLogObserver>());
+
+    Map map(view, fileSource, MapMode::Still);
+    map.setStyleJSON(style, "TEST_DATA/suite");
+
+    // The middle of the Atlantic Ocean.
+    map.setLatLngZoom({ 0, -30 }, 3);
+
+    std::promise<std::unique_ptr<const StillImage>> promise;
+    map.renderStill([&promise](std::exception_ptr, std::unique_ptr<const StillImage> image) {
+        promise.set_value(std::move(image));
+    });
+    auto result = promise.get_future().get();
+    ASSERT_EQ(256, result->width);
+    ASSERT_EQ(256, result->height);
+
+    // The water covers the red background. Pixels are RGBA in memory.
+    const StillImage::Pixel blue = 0xFFFF0000;
+    EXPECT_EQ(blue, result->pixels[128 * 256 + 128]);
+    EXPECT_EQ(blue, result->pixels[16 * 256 + 16]);
+    EXPECT_EQ(blue, result->pixels[240 * 256 + 240]);
+
+    auto observer = Log::removeObserver();
+    auto flo = dynamic_cast<FixtureLogObserver*>(observer.get());
+    auto unchecked = flo->unchecked();
+    EXPECT_TRUE(unchecked.empty()) << unchecked;
+}
@@ -0,0 +1,47 @@
+#include "parsers.hpp"
+
+#include <mbgl/platform/log.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// libFuzzer entry points. The fuzz targets in test.gypi build this file once per parser,
+// with MBGL_FUZZ_TARGET set to its name.
+#define MBGL_FUZZ_STRINGIFY(x) MBGL_FUZZ_STRINGIFY_(x)
+#define MBGL_FUZZ_STRINGIFY_(x) #x
+
+using namespace mbgl;
+
+namespace {
+
+const fuzz::Target* target = nullptr;
+
+}
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    const char* name = MBGL_FUZZ_STRINGIFY(MBGL_FUZZ_TARGET);
+    for (const auto& candidate : fuzz::targets()) {
+        if (std::strcmp(candidate.name, name) == 0) {
+            target = &candidate;
+        }
+    }
+    if (!target) {
+        std::cerr << "Unknown fuzz target " << name << std::endl;
+        std::abort();
+    }
+
+    // Malformed input makes the parsers log a lot, which would slow fuzzing down.
+    for (const auto event : { Event::ParseStyle, Event::ParseTile, Event::Sprite, Event::Image }) {
+        Log::setEventEnabled(event, false);
+    }
+
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) {
+    if (size <= fuzz::maxInputSize) {
+        target->parse(data, size);
+    }
+    return 0;
+}
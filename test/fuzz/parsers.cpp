@@ -0,0 +1,156 @@
+#include "parsers.hpp"
+
+#include <mbgl/annotation/sprite_parser.hpp>
+#include <mbgl/geometry/glyph_atlas.hpp>
+#include <mbgl/map/vector_tile.hpp>
+#include <mbgl/style/style_parser.hpp>
+#include <mbgl/text/font_stack.hpp>
+#include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/json.hpp>
+#include <mbgl/util/pbf.hpp>
+
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <string>
+
+namespace mbgl {
+namespace fuzz {
+
+namespace {
+
+// The protocol buffers that the map reads nest messages only a few levels deep.
+const int maxMessageDepth = 8;
+
+void walk(pbf message, int depth) {
+    while (message.next()) {
+        switch (message.value & 0x7) {
+        case 0:
+            message.svarint<int64_t>();
+            break;
+        case 1:
+            message.float64();
+            break;
+        case 2: {
+            const pbf field = message.message();
+            try {
+                std::vector<uint32_t> values;
+                pbf(field).packedVarints(values);
+            } catch (const pbf::exception&) {
+            }
+            if (depth < maxMessageDepth) {
+                try {
+                    walk(field, depth + 1);
+                } catch (const pbf::exception&) {
+                }
+            }
+            break;
+        }
+        case 5:
+            message.float32();
+            break;
+        default:
+            message.skip();
+            break;
+        }
+    }
+}
+
+}
+
+void parsePBF(const uint8_t* data, std::size_t size) {
+    try {
+        walk(pbf(data, size), 0);
+    } catch (const pbf::exception&) {
+    }
+}
+
+void parseVectorTile(const uint8_t* data, std::size_t size) {
+    try {
+        const VectorTile tile { pbf(data, size) };
+    } catch (const std::exception&) {
+    }
+
+    // VectorTile doesn't expose its layers, so decode them one by one, like it does.
+    try {
+        pbf tilePBF(data, size);
+        while (tilePBF.next(3)) { // layer
+            const VectorTileLayer layer(tilePBF.message());
+            for (std::size_t i = 0; i < layer.featureCount(); i++) {
+                try {
+                    const auto feature = layer.getFeature(i);
+                    feature->getGeometries();
+                    for (const auto key : { "class", "name", "type" }) {
+                        feature->getValue(key);
+                    }
+                } catch (const std::exception&) {
+                }
+            }
+        }
+    } catch (const std::exception&) {
+    }
+}
+
+void parseGlyphs(const uint8_t* data, std::size_t size) {
+    FontStack stack;
+    try {
+        parseGlyphPBF(stack, { reinterpret_cast<const char*>(data), size });
+    } catch (const pbf::exception&) {
+    }
+
+    // Copy the glyphs into an atlas, like a tile does when it places its labels.
+    std::u32string text;
+    stack.forEachGlyph([&text](const SDFGlyph& glyph) {
+        text += char32_t(glyph.id);
+    });
+    GlyphAtlas atlas(256, 256);
+    GlyphPositions positions;
+    atlas.addGlyphs(0, text, "fuzz", stack, positions);
+}
+
+void parseSprite(const uint8_t* data, std::size_t size) {
+    static const std::string blank = [] {
+        const std::string pixels(64 * 64 * 4, '\0');
+        return util::compress_png(64, 64, pixels.data());
+    }();
+
+    const uint8_t* const separator = std::find(data, data + size, '\0');
+    const std::string json(reinterpret_cast<const char*>(data), separator - data);
+    const std::string image = separator == data + size
+        ? blank
+        : std::string(reinterpret_cast<const char*>(separator + 1), data + size - separator - 1);
+
+    mbgl::parseSprite(image, json);
+}
+
+void parseStyle(const uint8_t* data, std::size_t size) {
+    // The parser needs a null terminated string.
+    const std::string json(reinterpret_cast<const char*>(data), size);
+    if (util::jsonDepth(json) > util::maxJSONDepth) {
+        return;
+    }
+
+    rapidjson::Document doc;
+    doc.Parse<0>(json.c_str());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        return;
+    }
+
+    StyleParser parser;
+    parser.parse(doc);
+}
+
+const std::vector<Target>& targets() {
+    static const std::vector<Target> all = {
+        { "pbf", parsePBF },
+        { "vector-tile", parseVectorTile },
+        { "glyphs", parseGlyphs },
+        { "sprite", parseSprite },
+        { "style", parseStyle },
+    };
+    return all;
+}
+
+}
+}
@@ -0,0 +1,47 @@
+#ifndef MBGL_TEST_FUZZ_PARSERS
+#define MBGL_TEST_FUZZ_PARSERS
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mbgl {
+namespace fuzz {
+
+// Each parser target feeds one input to a parser that reads data from the network, the way
+// the map does, and discards the result. Errors that the parsers report for malformed input
+// are expected, so only crashes, leaks and exceeded budgets count as failures.
+struct Target {
+    const char* name;
+    void (*parse)(const uint8_t* data, std::size_t size);
+};
+
+// Walks all fields of a protocol buffer, descending into those that parse as messages.
+void parsePBF(const uint8_t* data, std::size_t size);
+
+// Decodes a vector tile, and the geometries and some properties of all of its features.
+void parseVectorTile(const uint8_t* data, std::size_t size);
+
+// Adds the glyphs of a glyph range to a font stack.
+void parseGlyphs(const uint8_t* data, std::size_t size);
+
+// Parses sprite JSON up to the first null byte with the image that follows it, or with a
+// blank image if there is nothing after the JSON.
+void parseSprite(const uint8_t* data, std::size_t size);
+
+// Parses a style document, as setting a style does.
+void parseStyle(const uint8_t* data, std::size_t size);
+
+const std::vector<Target>& targets();
+
+// Inputs are at most this large. Each must be parsed within the time budget, allocating at
+// most the memory budget in total. The fuzz-% make targets pass similar limits to libFuzzer.
+const std::size_t maxInputSize = 1024 * 1024;
+const std::chrono::seconds timeBudget(1);
+const std::size_t memoryBudget = 256 * 1024 * 1024;
+
+}
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/allocation_stats.hpp>
+#include <mbgl/map/vector_tile.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/geometry/elements_buffer.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Compilers may elide new expressions, but not explicit calls of operator new.
+void allocate(std::size_t size) {
+    ::operator delete(::operator new(size));
+}
+
+}
+
+// Tests that need the counting allocator are reported as disabled unless it is built in.
+#ifdef MBGL_ALLOCATION_STATS
+#define ALLOCATION_STATS_TEST(name) name
+#else
+#define ALLOCATION_STATS_TEST(name) DISABLED_##name
+#endif
+
+TEST(AllocationStats, Tags) {
+    allocation::Counters counters;
+    {
+        const allocation::CountScope count(counters);
+        allocate(4);
+        {
+            const allocation::TagScope parse(allocation::Parse);
+            allocate(8);
+            {
+                const allocation::TagScope place(allocation::Place);
+                allocate(16);
+            }
+            allocate(8);
+        }
+    }
+
+    // Not counted anymore.
+    allocate(32);
+
+    if (!allocation::enabled) {
+        EXPECT_EQ(0u, counters.total().allocations);
+        return;
+    }
+
+    EXPECT_EQ(1u, counters[allocation::Untagged].allocations);
+    EXPECT_EQ(2u, counters[allocation::Parse].allocations);
+    EXPECT_EQ(16u, counters[allocation::Parse].bytes);
+    EXPECT_EQ(1u, counters[allocation::Place].allocations);
+    EXPECT_EQ(4u, counters.total().allocations);
+    EXPECT_EQ(0u, counters[allocation::Shape].allocations);
+}
+
+// Guards against allocation regressions in tile decoding and tessellation. The budgets leave
+// some headroom above the counts at the time of writing; lower them when an optimization
+// reduces the counts, and only raise them deliberately. They only run in builds configured
+// with ALLOCATION_STATS=1.
+TEST(AllocationStats, ALLOCATION_STATS_TEST(TileBudget)) {
+    const std::string data = util::read_file("test/fixtures/tiles/streets/15-17605-10749.vector.pbf");
+
+    FillVertexBuffer fillVertexBuffer;
+    LineVertexBuffer lineVertexBuffer;
+    TriangleElementsBuffer triangleElementsBuffer;
+    LineElementsBuffer lineElementsBuffer;
+
+    allocation::Counters counters;
+    {
+        const allocation::CountScope count(counters);
+        const allocation::TagScope tag(allocation::Parse);
+
+        VectorTile tile(pbf(reinterpret_cast<const unsigned char *>(data.data()), data.size()));
+
+        FillBucket fill(fillVertexBuffer, triangleElementsBuffer, lineElementsBuffer);
+        for (const auto& name : { "landuse", "water", "building" }) {
+            auto layer = tile.getLayer(name);
+            ASSERT_TRUE(layer.get());
+            for (std::size_t i = 0; i < layer->featureCount(); i++) {
+                fill.addGeometry(layer->getFeature(i)->getGeometries());
+            }
+        }
+
+        LineBucket line(lineVertexBuffer, triangleElementsBuffer);
+        for (const auto& name : { "road", "tunnel", "bridge", "barrier_line" }) {
+            auto layer = tile.getLayer(name);
+            ASSERT_TRUE(layer.get());
+            for (std::size_t i = 0; i < layer->featureCount(); i++) {
+                line.addGeometry(layer->getFeature(i)->getGeometries());
+            }
+        }
+    }
+
+    EXPECT_LE(counters[allocation::Parse].allocations, 7500u) << allocation::toString(counters);
+    EXPECT_LE(counters[allocation::Tessellate].allocations, 32000u) << allocation::toString(counters);
+}
@@ -0,0 +1,177 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/map/bucket_cache.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/geometry/elements_buffer.hpp>
+
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace mbgl;
+
+namespace {
+
+struct TileBuffers {
+    FillVertexBuffer fillVertex;
+    LineVertexBuffer lineVertex;
+    TriangleElementsBuffer triangleElements;
+    LineElementsBuffer lineElements;
+
+    BucketCache::Buffers get() {
+        return { fillVertex, lineVertex, triangleElements, lineElements };
+    }
+};
+
+template <typename Buffer>
+bool equal(const Buffer& a, const Buffer& b) {
+    return a.bytes() == b.bytes() && std::memcmp(a.data(), b.data(), a.bytes()) == 0;
+}
+
+// Creates an empty directory and deletes it with its files at the end of the test.
+class TemporaryDirectory {
+public:
+    TemporaryDirectory() {
+        if (!mkdtemp(path)) {
+            path[0] = 0;
+        }
+    }
+
+    ~TemporaryDirectory() {
+        for (const auto& file : files()) {
+            unlink(file.c_str());
+        }
+        rmdir(path);
+    }
+
+    std::vector<std::string> files() const {
+        std::vector<std::string> result;
+        if (DIR* dir = opendir(path)) {
+            while (const dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] != '.') {
+                    result.push_back(std::string(path) + "/" + entry->d_name);
+                }
+            }
+            closedir(dir);
+        }
+        return result;
+    }
+
+    char path[32] = "/tmp/mbgl-bucket-cache-XXXXXX";
+};
+
+void addLines(LineVertexBuffer& vertices, TriangleElementsBuffer& elements, BucketCache::Buckets& buckets) {
+    for (const auto name : { "roads", "rivers" }) {
+        auto bucket = std::make_unique<LineBucket>(vertices, elements);
+        bucket->layout.cap = CapType::Round;
+        bucket->addGeometry(std::vector<Coordinate> {{ 0, 0 }, { 100, 50 }, { 200, 0 }});
+        EXPECT_TRUE(bucket->hasData());
+        buckets.emplace(name, std::move(bucket));
+    }
+}
+
+void setUsed(const std::string& file, time_t time) {
+    const struct timeval times[2] = { { time, 0 }, { time, 0 } };
+    utimes(file.c_str(), times);
+}
+
+time_t getUsed(const std::string& file) {
+    struct stat info;
+    return stat(file.c_str(), &info) == 0 ? info.st_mtime : 0;
+}
+
+}
+
+TEST(BucketCache, RoundTrip) {
+    const TemporaryDirectory directory;
+    ASSERT_TRUE(directory.path[0]);
+
+    const TileID id(14, 8800, 5373, 14);
+    const std::size_t dataHash = 7;
+    const BucketCache cache(directory.path, 1024 * 1024, 42);
+
+    TileBuffers original;
+    BucketCache::Buckets buckets;
+    addLines(original.lineVertex, original.triangleElements, buckets);
+
+    auto buffers = original.get();
+    cache.save("mapbox", id, dataHash, buffers, buckets);
+
+    TileBuffers restored;
+    BucketCache::Buckets restoredBuckets;
+    auto restoredBuffers = restored.get();
+
+    // Keys that differ in source, tile, tile data or layout miss the cache.
+    EXPECT_FALSE(cache.load("other", id, dataHash, restoredBuffers, restoredBuckets));
+    EXPECT_FALSE(cache.load("mapbox", TileID(14, 8800, 5373, 13), dataHash, restoredBuffers, restoredBuckets));
+    EXPECT_FALSE(cache.load("mapbox", id, dataHash + 1, restoredBuffers, restoredBuckets));
+    EXPECT_FALSE(BucketCache(directory.path, 1024 * 1024, 43).load("mapbox", id, dataHash, restoredBuffers, restoredBuckets));
+    EXPECT_TRUE(restored.lineVertex.empty());
+
+    ASSERT_TRUE(cache.load("mapbox", id, dataHash, restoredBuffers, restoredBuckets));
+    EXPECT_TRUE(equal(original.lineVertex, restored.lineVertex));
+    EXPECT_TRUE(equal(original.triangleElements, restored.triangleElements));
+    ASSERT_EQ(2u, restoredBuckets.size());
+    for (const auto& entry : restoredBuckets) {
+        const auto& bucket = dynamic_cast<LineBucket&>(*entry.second);
+        EXPECT_TRUE(bucket.hasData());
+        EXPECT_EQ(CapType::Round, bucket.layout.cap);
+    }
+}
+
+TEST(BucketCache, DeletesLeastRecentlyUsed) {
+    const TemporaryDirectory directory;
+    ASSERT_TRUE(directory.path[0]);
+
+    TileBuffers original;
+    BucketCache::Buckets buckets;
+    addLines(original.lineVertex, original.triangleElements, buckets);
+    auto buffers = original.get();
+
+    // All files have the same size. Measure it with a cache without a limit.
+    BucketCache(directory.path, uint64_t(-1), 42).save("mapbox", TileID(1, 0, 0, 1), 1, buffers, buckets);
+    ASSERT_EQ(1u, directory.files().size());
+    struct stat info;
+    ASSERT_EQ(0, stat(directory.files().front().c_str(), &info));
+    const uint64_t fileSize = info.st_size;
+
+    // Room for two and a half files.
+    const BucketCache cache(directory.path, fileSize * 5 / 2, 42);
+    cache.save("mapbox", TileID(1, 0, 1, 1), 1, buffers, buckets);
+    ASSERT_EQ(2u, directory.files().size());
+
+    // Make the first file the oldest, then use it.
+    const time_t past = time(nullptr) - 1000;
+    for (const auto& file : directory.files()) {
+        setUsed(file, past);
+    }
+
+    TileBuffers restored;
+    BucketCache::Buckets restoredBuckets;
+    auto restoredBuffers = restored.get();
+    ASSERT_TRUE(cache.load("mapbox", TileID(1, 0, 0, 1), 1, restoredBuffers, restoredBuckets));
+    std::size_t used = 0;
+    for (const auto& file : directory.files()) {
+        used += getUsed(file) > past;
+    }
+    EXPECT_EQ(1u, used);
+
+    // The third file pushes the directory over the limit, so the tile that wasn't used goes.
+    cache.save("mapbox", TileID(1, 1, 1, 1), 1, buffers, buckets);
+    EXPECT_EQ(2u, directory.files().size());
+
+    for (const auto& tile : { TileID(1, 0, 0, 1), TileID(1, 1, 1, 1) }) {
+        TileBuffers tileBuffers;
+        BucketCache::Buckets tileBuckets;
+        auto loadBuffers = tileBuffers.get();
+        EXPECT_TRUE(cache.load("mapbox", tile, 1, loadBuffers, tileBuckets)) << std::string(tile);
+    }
+    TileBuffers missing;
+    BucketCache::Buckets missingBuckets;
+    auto missingBuffers = missing.get();
+    EXPECT_FALSE(cache.load("mapbox", TileID(1, 0, 1, 1), 1, missingBuffers, missingBuckets));
+}
@@ -0,0 +1,67 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/renderer/frame_profiler.hpp>
+#include <mbgl/gl/stats.hpp>
+
+using namespace mbgl;
+
+TEST(FrameStats, Counters) {
+    FrameProfiler profiler;
+
+    // Nothing is counted outside of a frame.
+    gl::stats::drawCall();
+
+    profiler.beginFrame();
+    {
+        const FrameProfiler::PassScope scope(profiler, FrameStats::Opaque);
+        gl::stats::drawCall();
+        gl::stats::drawCall();
+        gl::stats::upload(1024);
+        profiler.countBucket();
+    }
+    profiler.countTiles(3);
+    profiler.endFrame();
+
+    gl::stats::upload(1024);
+
+    const FrameStats& stats = profiler.getLastFrame();
+    EXPECT_EQ(1u, stats.frame);
+    EXPECT_EQ(2u, stats.drawCalls);
+    EXPECT_EQ(1u, stats.uploads);
+    EXPECT_EQ(1024u, stats.bytesUploaded);
+    EXPECT_EQ(3u, stats.tiles);
+    EXPECT_EQ(1u, stats.buckets);
+    EXPECT_EQ(Duration::zero(), stats.cpuTime[FrameStats::Translucent]);
+    EXPECT_EQ(stats.cpuTime[FrameStats::Opaque], stats.totalCPUTime());
+
+    // There is no GL context, so there are no timer queries either.
+    EXPECT_FALSE(stats.gpuTimeAvailable);
+}
+
+TEST(FrameStats, History) {
+    FrameProfiler profiler;
+
+    const auto renderFrame = [&profiler] {
+        profiler.beginFrame();
+        profiler.endFrame();
+    };
+
+    renderFrame();
+    EXPECT_TRUE(profiler.getHistory().empty());
+
+    profiler.setHistorySize(3);
+    for (int i = 0; i < 5; i++) {
+        renderFrame();
+    }
+
+    const auto history = profiler.getHistory();
+    ASSERT_EQ(3u, history.size());
+    EXPECT_EQ(4u, history[0].frame);
+    EXPECT_EQ(5u, history[1].frame);
+    EXPECT_EQ(6u, history[2].frame);
+    EXPECT_EQ(6u, profiler.getLastFrame().frame);
+
+    profiler.setHistorySize(1);
+    ASSERT_EQ(1u, profiler.getHistory().size());
+    EXPECT_EQ(6u, profiler.getHistory()[0].frame);
+}
@@ -0,0 +1,89 @@
+#include "../fixtures/util.hpp"
+#include "../fuzz/parsers.hpp"
+
+#include <mbgl/platform/log.hpp>
+#include <mbgl/util/allocation_stats.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <dirent.h>
+
+using namespace mbgl;
+
+namespace {
+
+// The fuzzer enforces fuzz::timeBudget itself. Here, the inputs also run in Debug builds and
+// under sanitizers or valgrind, so this only catches the ones that take far longer.
+const auto regressionTimeBudget = fuzz::timeBudget * 20;
+
+// The inputs in test/fixtures/fuzz/<target>, named <target>/<file>.
+std::vector<std::string> corpus() {
+    std::vector<std::string> names;
+    for (const auto& target : fuzz::targets()) {
+        const std::string directory = std::string("test/fixtures/fuzz/") + target.name;
+        DIR *dir = opendir(directory.c_str());
+        if (dir != nullptr) {
+            for (dirent *dp = nullptr; (dp = readdir(dir)) != nullptr;) {
+                const std::string file = dp->d_name;
+                if (file[0] != '.') {
+                    names.push_back(std::string(target.name) + "/" + file);
+                }
+            }
+            closedir(dir);
+        }
+    }
+    return names;
+}
+
+}
+
+TEST(FuzzCorpus, NotEmpty) {
+    EXPECT_LT(0u, corpus().size());
+}
+
+// Runs the inputs that crashed a parser or exceeded its budgets while fuzzing, which are kept
+// in test/fixtures/fuzz/<target>. See `make fuzz-%`.
+class FuzzCorpusTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(FuzzCorpusTest, WithinBudget) {
+    const std::string name = GetParam();
+    const std::string targetName = name.substr(0, name.find('/'));
+
+    const auto& targets = fuzz::targets();
+    const auto target = std::find_if(targets.begin(), targets.end(), [&](const fuzz::Target& t) {
+        return targetName == t.name;
+    });
+    ASSERT_NE(targets.end(), target) << "No fuzz target is named " << targetName;
+
+    const std::string input = util::read_file("test/fixtures/fuzz/" + name);
+    ASSERT_LE(input.size(), fuzz::maxInputSize);
+
+    // The inputs are malformed, and logging all that is wrong with them would take longer than
+    // parsing them.
+    const auto events = { Event::ParseStyle, Event::ParseTile, Event::Sprite, Event::Image };
+    for (const auto event : events) {
+        Log::setEventEnabled(event, false);
+    }
+
+    allocation::Counters counters;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const allocation::CountScope count(counters);
+        target->parse(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    for (const auto event : events) {
+        Log::setEventEnabled(event, true);
+    }
+
+    EXPECT_LE(elapsed, regressionTimeBudget)
+        << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms";
+    if (allocation::enabled) {
+        EXPECT_LE(counters.total().bytes, fuzz::memoryBudget) << allocation::toString(counters);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(FuzzCorpus, FuzzCorpusTest, ::testing::ValuesIn(corpus()));
@@ -0,0 +1,119 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/text/font_stack.hpp>
+#include <mbgl/text/glyph_store.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+#include <uv.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class StopWhenLoaded : public GlyphStore::Observer {
+public:
+    StopWhenLoaded(GlyphStore& store_, util::RunLoop& loop_, const std::set<GlyphRange>& ranges_)
+        : store(store_), loop(loop_), ranges(ranges_) {}
+
+    void onGlyphRangeLoaded() override {
+        if (store.hasGlyphRanges("Test", ranges)) {
+            loop.stop();
+        }
+    }
+
+    void onGlyphRangeLoadingFailed(std::exception_ptr) override {
+        failed = true;
+        loop.stop();
+    }
+
+    bool failed = false;
+
+private:
+    GlyphStore& store;
+    util::RunLoop& loop;
+    const std::set<GlyphRange>& ranges;
+};
+
+}
+
+TEST(FontStack, CopiesShareRanges) {
+    SDFGlyph glyph;
+    glyph.id = 'A';
+    FontStack stack;
+    stack.insert(glyph.id, glyph);
+
+    FontStack copy = stack;
+    glyph.id = 0x4E00;
+    copy.insert(glyph.id, glyph);
+
+    // The copy shares the glyphs of the first range, but not the range it added to.
+    EXPECT_EQ(stack.getGlyph('A'), copy.getGlyph('A'));
+    EXPECT_EQ(nullptr, stack.getGlyph(0x4E00));
+    ASSERT_NE(nullptr, copy.getGlyph(0x4E00));
+    EXPECT_EQ(0x4E00u, copy.getGlyph(0x4E00)->id);
+
+    // Inserting into a shared range doesn't change the other font stack.
+    glyph.id = 'B';
+    copy.insert(glyph.id, glyph);
+    EXPECT_NE(stack.getGlyph('A'), copy.getGlyph('A'));
+    EXPECT_EQ(nullptr, stack.getGlyph('B'));
+}
+
+TEST(GlyphStore, ConcurrentReaders) {
+    util::RunLoop loop(uv_default_loop());
+    DefaultFileSource fileSource(nullptr);
+    util::ThreadContext::setFileSource(&fileSource);
+
+    GlyphStore store(uv_default_loop());
+    // Every range loads the same file, so each one adds to the glyphs of the first range.
+    store.setURL("asset://TEST_DATA/fixtures/resources/glyphs.pbf");
+
+    std::set<GlyphRange> ranges;
+    for (uint32_t i = 0; i < 64; i++) {
+        ranges.insert(getGlyphRange(i * 256));
+    }
+
+    StopWhenLoaded observer(store, loop, ranges);
+    store.setObserver(&observer);
+
+    // Readers look up glyphs in whatever snapshot is current while the ranges are added.
+    std::atomic<bool> done { false };
+    std::atomic<bool> consistent { true };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                const auto stack = store.getFontStack("Test");
+                if (!stack) {
+                    continue;
+                }
+                const SDFGlyph* glyph = stack->getGlyph('A');
+                if (!glyph || glyph->id != 'A' || glyph->bitmap.size() !=
+                        (glyph->metrics.width + 6) * (glyph->metrics.height + 6)) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+
+    store.requestGlyphRangesIfNeeded("Test", ranges);
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    store.setObserver(nullptr);
+    util::ThreadContext::setFileSource(nullptr);
+
+    EXPECT_FALSE(observer.failed);
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(store.hasGlyphRanges("Test", ranges));
+}
@@ -0,0 +1,20 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/json.hpp>
+
+using namespace mbgl;
+
+TEST(JSON, Depth) {
+    EXPECT_EQ(0u, util::jsonDepth(""));
+    EXPECT_EQ(0u, util::jsonDepth("42"));
+    EXPECT_EQ(1u, util::jsonDepth("{}"));
+    EXPECT_EQ(3u, util::jsonDepth("{\"a\":[1,{\"b\":2}],\"c\":[]}"));
+
+    // Brackets in strings don't count, including after escaped quotes.
+    EXPECT_EQ(1u, util::jsonDepth("[\"[[{{\"]"));
+    EXPECT_EQ(1u, util::jsonDepth("[\"\\\"[[\"]"));
+
+    const std::string deep = std::string(10000, '[') + std::string(10000, ']');
+    EXPECT_EQ(10000u, util::jsonDepth(deep));
+    EXPECT_LT(util::maxJSONDepth, util::jsonDepth(deep));
+}
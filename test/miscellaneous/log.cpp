@@ -0,0 +1,83 @@
+#include "../fixtures/util.hpp"
+#include "../fixtures/fixture_log_observer.hpp"
+
+#include <mbgl/platform/log.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(Log, RuntimeFilters) {
+    FixtureLog log;
+
+    Log::setMinimumSeverity(EventSeverity::Warning);
+    Log::Info(Event::General, "filtered by severity");
+    Log::Warning(Event::General, "recorded");
+    Log::setMinimumSeverity(EventSeverity::Debug);
+
+    Log::setEventEnabled(Event::Sprite, false);
+    Log::Warning(Event::Sprite, "filtered by event");
+    Log::setEventEnabled(Event::Sprite, true);
+    Log::Warning(Event::Sprite, "recorded");
+
+    EXPECT_EQ(0u, log.count({ EventSeverity::Info, Event::General, -1, "filtered by severity" }));
+    EXPECT_EQ(1u, log.count({ EventSeverity::Warning, Event::General, -1, "recorded" }));
+    EXPECT_EQ(0u, log.count({ EventSeverity::Warning, Event::Sprite, -1, "filtered by event" }));
+    EXPECT_EQ(1u, log.count({ EventSeverity::Warning, Event::Sprite, -1, "recorded" }));
+}
+
+TEST(Log, RateLimit) {
+    FixtureLog log;
+
+    Log::setRateLimit(3);
+    for (int i = 0; i < 10; i++) {
+        Log::Warning(Event::General, "repeated %d", 0);
+        Log::Warning(Event::General, "tile %d/%d/%d failed", 14, i, i);
+        Log::Warning(Event::General, std::string("caller formatted tile ") + std::to_string(i));
+        Log::Info(Event::General, "info %d", i);
+    }
+    Log::setRateLimit(Log::defaultRateLimit);
+
+    // Messages are limited by their format string, and messages that the caller formatted by
+    // their text without digits.
+    EXPECT_EQ(3u, log.count({ EventSeverity::Warning, Event::General, -1, "repeated 0" }));
+    EXPECT_EQ(1u, log.count({ EventSeverity::Warning, Event::General, -1, "tile 14/2/2 failed" }));
+    EXPECT_EQ(0u, log.count({ EventSeverity::Warning, Event::General, -1, "tile 14/3/3 failed" }));
+    EXPECT_EQ(1u, log.count({ EventSeverity::Warning, Event::General, -1, "caller formatted tile 2" }));
+    EXPECT_EQ(0u, log.count({ EventSeverity::Warning, Event::General, -1, "caller formatted tile 3" }));
+
+    // Debug and info messages aren't limited.
+    EXPECT_EQ(1u, log.count({ EventSeverity::Info, Event::General, -1, "info 9" }));
+
+    // The suppressed messages are reported on flush.
+    Log::flush();
+    EXPECT_EQ(3u, log.count({ EventSeverity::Warning, Event::General, -1, "7 similar messages were suppressed" }));
+}
+
+namespace {
+
+std::vector<std::string> written;
+
+void writeMessage(EventSeverity, const std::string& msg) {
+    written.push_back(msg);
+}
+
+}
+
+TEST(Log, AsyncSink) {
+    // Without an observer, messages go to the writer on the sink thread.
+    Log::setWriter(writeMessage);
+    for (int i = 0; i < 3; i++) {
+        Log::Warning(Event::General, "written by the sink %d", i);
+    }
+    Log::flush();
+    Log::setWriter(nullptr);
+
+    ASSERT_EQ(3u, written.size());
+    for (std::size_t i = 0; i < written.size(); i++) {
+        const std::string suffix = "[General]: written by the sink " + std::to_string(i);
+        ASSERT_LE(suffix.size(), written[i].size());
+        EXPECT_EQ(suffix, written[i].substr(written[i].size() - suffix.size()));
+    }
+}
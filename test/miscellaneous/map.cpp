@@ -57,3 +57,25 @@ TEST(Map, DestroyPaused) {
 
     map.pause();
 }
+
+TEST(Map, TileLOD) {
+    using namespace mbgl;
+
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    DefaultFileSource fileSource(nullptr);
+
+    Map map(view, fileSource, MapMode::Continuous);
+    EXPECT_FALSE(map.getTileLOD().isEnabled());
+
+    TileLOD lod;
+    lod.focusRadius = 256;
+    lod.maxLevelDrop = 2;
+    lod.tileBudget = 100;
+    map.setTileLOD(lod);
+
+    EXPECT_TRUE(map.getTileLOD().isEnabled());
+    EXPECT_EQ(256, map.getTileLOD().focusRadius);
+    EXPECT_EQ(2, map.getTileLOD().maxLevelDrop);
+    EXPECT_EQ(100u, map.getTileLOD().tileBudget);
+}
@@ -0,0 +1,110 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/memory_usage.hpp>
+#include <mbgl/map/still_image.hpp>
+#include <mbgl/geometry/elements_buffer.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/text/font_stack.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <future>
+
+using namespace mbgl;
+
+TEST(MemoryUsage, ReclaimOrder) {
+    MemoryUsage usage;
+    usage.categories[MemoryUsage::Tiles] = { 5000, 5000 };
+    usage.categories[MemoryUsage::TileCache] = { 300, 200 };
+    usage.categories[MemoryUsage::TexturePool] = { 0, 2000 };
+    usage.categories[MemoryUsage::GlyphAtlas] = { 1000, 1000 };
+
+    EXPECT_EQ(14500u, usage.total().total());
+
+    // Categories that are in use are never freed, and empty ones are skipped.
+    using Order = std::vector<MemoryUsage::Category>;
+    EXPECT_EQ(Order({ MemoryUsage::TexturePool, MemoryUsage::TileCache }), usage.reclaimOrder());
+    EXPECT_EQ(Order({ MemoryUsage::TexturePool }), usage.reclaimOrder(1000));
+    EXPECT_EQ(Order({ MemoryUsage::TexturePool, MemoryUsage::TileCache }), usage.reclaimOrder(2001));
+    EXPECT_EQ(Order(), usage.reclaimOrder(0));
+}
+
+TEST(MemoryUsage, Buffer) {
+    LineElementsBuffer buffer;
+    EXPECT_EQ(0u, buffer.getMemoryFootprint().total());
+
+    buffer.add(0, 1);
+    buffer.add(1, 2);
+
+    // Until the buffer is uploaded, it is in main memory, including its unused capacity.
+    EXPECT_EQ(8192u, buffer.getMemoryFootprint().cpu);
+    EXPECT_EQ(0u, buffer.getMemoryFootprint().gpu);
+    EXPECT_EQ(4u, buffer.getMemoryFootprint(1).cpu);
+}
+
+TEST(MemoryUsage, FontStack) {
+    FontStack stack;
+    EXPECT_EQ(0u, stack.getMemoryFootprint().total());
+
+    SDFGlyph glyph;
+    glyph.id = 65;
+    glyph.bitmap = std::string(1000, 'a');
+    stack.insert(glyph.id, glyph);
+
+    const MemoryFootprint footprint = stack.getMemoryFootprint();
+    EXPECT_LT(1000u, footprint.cpu);
+    EXPECT_GT(2000u, footprint.cpu);
+    EXPECT_EQ(0u, footprint.gpu);
+}
+
+namespace {
+
+void renderOnce(Map& map) {
+    std::promise<void> done;
+    map.renderStill([&done](std::exception_ptr, std::unique_ptr<const StillImage>) {
+        done.set_value();
+    });
+    done.get_future().get();
+}
+
+}
+
+TEST(MemoryUsage, Map) {
+    // A single z0 tile with a fill layer.
+    const auto style = util::read_file("test/fixtures/api/overscaled_water.json");
+
+    auto display = std::make_shared<HeadlessDisplay>();
+    HeadlessView view(display, 1, 256, 256);
+    DefaultFileSource fileSource(nullptr);
+
+    Map map(view, fileSource, MapMode::Still);
+    map.setStyleJSON(style, "TEST_DATA/suite");
+    map.setLatLngZoom({ 0, -30 }, 0);
+    renderOnce(map);
+
+    const MemoryUsage alone = map.getMemoryUsage();
+    EXPECT_LE(1u, alone.tiles);
+    EXPECT_LT(0u, alone.categories[MemoryUsage::Tiles].cpu);
+
+    MemoryFootprint sum;
+    for (const auto& category : alone.categories) {
+        sum += category;
+    }
+    EXPECT_EQ(sum.cpu, alone.total().cpu);
+    EXPECT_EQ(sum.gpu, alone.total().gpu);
+
+    // Another Map that shows the same tile shares its data, and each of them counts half of it.
+    HeadlessView otherView(display, 1, 256, 256);
+    Map other(otherView, fileSource, MapMode::Still);
+    other.setStyleJSON(style, "TEST_DATA/suite");
+    other.setLatLngZoom({ 0, -30 }, 0);
+    renderOnce(other);
+
+    const MemoryUsage shared = map.getMemoryUsage();
+    const MemoryUsage otherShared = other.getMemoryUsage();
+    EXPECT_GT(alone.categories[MemoryUsage::Tiles].cpu, shared.categories[MemoryUsage::Tiles].cpu);
+    EXPECT_GT(alone.categories[MemoryUsage::Tiles].cpu * 2,
+              shared.categories[MemoryUsage::Tiles].cpu + otherShared.categories[MemoryUsage::Tiles].cpu);
+}
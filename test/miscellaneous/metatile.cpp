@@ -0,0 +1,93 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/map/metatile.hpp>
+#include <mbgl/map/still_image.hpp>
+
+using namespace mbgl;
+
+TEST(Metatile, Dimensions) {
+    const Metatile meta(4, 2, 3, 4);
+    EXPECT_EQ(4, meta.columns);
+    EXPECT_EQ(4, meta.rows);
+    EXPECT_EQ(1024u, meta.getWidth());
+    EXPECT_EQ(1024u, meta.getHeight());
+
+    const Metatile buffered(4, 2, 3, 2, 256, 32);
+    EXPECT_EQ(576u, buffered.getWidth());
+    EXPECT_EQ(576u, buffered.getHeight());
+
+    // Metatiles are clipped to the edges of the world.
+    const Metatile clipped(2, 2, 3, 4);
+    EXPECT_EQ(2, clipped.columns);
+    EXPECT_EQ(1, clipped.rows);
+
+    EXPECT_THROW(Metatile(2, 4, 0, 4), std::out_of_range);
+
+    // Dimensions that don't fit into 16 bits used to wrap around.
+    const Metatile largest(10, 0, 0, 255);
+    EXPECT_EQ(65280u, largest.getWidth());
+    EXPECT_THROW(Metatile(10, 0, 0, 256), std::invalid_argument);
+    EXPECT_THROW(Metatile(10, 0, 0, 255, 256, 128), std::invalid_argument);
+    EXPECT_THROW(Metatile(10, 0, 0, 1, 256, 65535), std::invalid_argument);
+}
+
+TEST(Metatile, FramebufferSize) {
+    const Metatile meta(10, 0, 0, 64);
+    EXPECT_EQ(16384u, meta.getFramebufferWidth(1));
+    EXPECT_EQ(32768u, meta.getFramebufferHeight(2));
+    EXPECT_EQ(24576u, meta.getFramebufferWidth(1.5));
+
+    // The limit applies to physical pixels.
+    EXPECT_NO_THROW(meta.checkFramebufferSize(1, 16384));
+    EXPECT_THROW(meta.checkFramebufferSize(2, 16384), std::invalid_argument);
+    EXPECT_NO_THROW(meta.checkFramebufferSize(2, 32768));
+
+    const Metatile buffered(10, 0, 0, 32, 256, 1);
+    EXPECT_THROW(buffered.checkFramebufferSize(2, 16384), std::invalid_argument);
+}
+
+TEST(Metatile, Center) {
+    const Metatile world(1, 0, 0, 2);
+    EXPECT_NEAR(0, world.getCenter().latitude, 1e-9);
+    EXPECT_NEAR(0, world.getCenter().longitude, 1e-9);
+    EXPECT_DOUBLE_EQ(0, world.getZoom());
+
+    const Metatile quadrant(2, 0, 0, 2);
+    EXPECT_NEAR(66.51326044311186, quadrant.getCenter().latitude, 1e-9);
+    EXPECT_NEAR(-90, quadrant.getCenter().longitude, 1e-9);
+    EXPECT_DOUBLE_EQ(1, quadrant.getZoom());
+
+    const Metatile large(2, 0, 0, 1, 512);
+    EXPECT_DOUBLE_EQ(2, large.getZoom());
+}
+
+TEST(Metatile, Slice) {
+    // Render a 2×2 metatile with 1 px tiles and a 1 px buffer at pixel ratio 2.
+    const Metatile meta(3, 4, 4, 2, 1, 1);
+
+    StillImage image;
+    image.width = 8;
+    image.height = 8;
+    image.pixels = std::make_unique<StillImage::Pixel[]>(image.width * image.height);
+    for (uint32_t i = 0; i < image.width * image.height; i++) {
+        image.pixels[i] = i;
+    }
+
+    const auto tiles = meta.slice(image);
+    ASSERT_EQ(4u, tiles.size());
+
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(2, tile->width);
+        EXPECT_EQ(2, tile->height);
+    }
+
+    EXPECT_EQ(18u, tiles[0]->pixels[0]);
+    EXPECT_EQ(19u, tiles[0]->pixels[1]);
+    EXPECT_EQ(26u, tiles[0]->pixels[2]);
+    EXPECT_EQ(27u, tiles[0]->pixels[3]);
+
+    EXPECT_EQ(20u, tiles[1]->pixels[0]);
+    EXPECT_EQ(34u, tiles[2]->pixels[0]);
+    EXPECT_EQ(36u, tiles[3]->pixels[0]);
+    EXPECT_EQ(45u, tiles[3]->pixels[3]);
+}
@@ -0,0 +1,61 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/metrics_registry.hpp>
+#include <mbgl/map/tile_cache.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Metrics stay registered for the lifetime of the process, so they can't be local variables.
+metrics::Counter testCounter("test.counter");
+metrics::Gauge testGauge("test.gauge");
+metrics::Histogram testHistogram("test.histogram_ms", 10);
+
+}
+
+TEST(Metrics, Snapshot) {
+    const auto before = metrics::snapshot();
+
+    testCounter.add();
+    testCounter.add(4);
+    testGauge.add(10);
+    testGauge.subtract(3);
+
+    testHistogram.record(0);
+    testHistogram.record(9);
+    testHistogram.record(10);
+    testHistogram.record(25);
+    testHistogram.record(uint64_t(1) << 40);
+
+    const auto after = metrics::snapshot();
+    EXPECT_EQ(5u, after.counters.at("test.counter") - before.counters.at("test.counter"));
+    EXPECT_EQ(7, after.gauges.at("test.gauge") - before.gauges.at("test.gauge"));
+
+    const auto& histogram = after.histograms.at("test.histogram_ms");
+    ASSERT_EQ(metrics::Histogram::BucketCount - 1, histogram.bounds.size());
+    ASSERT_EQ(metrics::Histogram::BucketCount, histogram.counts.size());
+    EXPECT_EQ(10u, histogram.bounds[0]);
+    EXPECT_EQ(20u, histogram.bounds[1]);
+    EXPECT_EQ(40u, histogram.bounds[2]);
+
+    EXPECT_EQ(5u, histogram.count);
+    EXPECT_EQ(2u, histogram.counts[0]);
+    EXPECT_EQ(1u, histogram.counts[1]);
+    EXPECT_EQ(1u, histogram.counts[2]);
+    // Values beyond the last bound go to the last bucket.
+    EXPECT_EQ(1u, histogram.counts.back());
+    EXPECT_EQ(44u + (uint64_t(1) << 40), histogram.sum);
+}
+
+TEST(Metrics, TileCache) {
+    const auto before = metrics::snapshot();
+
+    TileCache cache(4);
+    EXPECT_FALSE(cache.get(1));
+    EXPECT_FALSE(cache.get(2));
+
+    const auto after = metrics::snapshot();
+    EXPECT_EQ(2u, after.counters.at("tile_cache.misses") - before.counters.at("tile_cache.misses"));
+    EXPECT_EQ(0u, after.counters.at("tile_cache.hits") - before.counters.at("tile_cache.hits"));
+}
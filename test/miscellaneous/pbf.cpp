@@ -0,0 +1,116 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/pbf.hpp>
+
+#include <random>
+#include <typeinfo>
+
+using namespace mbgl;
+
+namespace {
+
+void encode(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    bytes.push_back(uint8_t(value));
+}
+
+// Decodes the bytes with the scalar and the batched decoder. Returns the name of the exception
+// type that was thrown, if any.
+std::string decodeScalar(const std::vector<uint8_t>& bytes, std::vector<uint32_t>& out) {
+    pbf data(bytes.data(), bytes.size());
+    try {
+        while (data) {
+            out.push_back(static_cast<uint32_t>(data.varint<uint64_t>()));
+        }
+    } catch (const pbf::exception& ex) {
+        return typeid(ex).name();
+    }
+    return "";
+}
+
+std::string decodeBatched(const std::vector<uint8_t>& bytes, std::vector<uint32_t>& out) {
+    pbf data(bytes.data(), bytes.size());
+    try {
+        data.packedVarints(out);
+    } catch (const pbf::exception& ex) {
+        return typeid(ex).name();
+    }
+    return "";
+}
+
+// Decodes with the buffer based decoder, at most `capacity` values at a time.
+std::string decodeChunked(const std::vector<uint8_t>& bytes, std::size_t capacity, std::vector<uint32_t>& out) {
+    pbf data(bytes.data(), bytes.size());
+    std::vector<uint32_t> chunk(capacity);
+    try {
+        while (data.data < data.end) {
+            const std::size_t count = data.packedVarints(chunk.data(), capacity);
+            EXPECT_LT(0u, count);
+            EXPECT_GE(capacity, count);
+            out.insert(out.end(), chunk.begin(), chunk.begin() + count);
+        }
+    } catch (const pbf::exception& ex) {
+        return typeid(ex).name();
+    }
+    return "";
+}
+
+}
+
+TEST(PBF, PackedVarints) {
+    std::vector<uint8_t> bytes;
+    const std::vector<uint32_t> expected = {
+        0, 1, 127, 128, 300, 16383, 16384, 2097151, 2097152, 268435455, 268435456, 4294967295u,
+        5, 6, 7, 8, 9, 10, 11, 12, 13
+    };
+    for (const auto value : expected) {
+        encode(bytes, value);
+    }
+
+    std::vector<uint32_t> values;
+    pbf(bytes.data(), bytes.size()).packedVarints(values);
+    EXPECT_EQ(expected, values);
+
+    EXPECT_EQ(0, pbf::zigzag(0));
+    EXPECT_EQ(-1, pbf::zigzag(1));
+    EXPECT_EQ(1, pbf::zigzag(2));
+    EXPECT_EQ(-2147483647 - 1, pbf::zigzag(4294967295u));
+}
+
+// Compares the batched decoder with the scalar one on random input, including varints that
+// are longer than 32 bits, too long or unterminated.
+TEST(PBF, PackedVarintsFuzz) {
+    std::mt19937 random(1337);
+
+    for (int run = 0; run < 20000; run++) {
+        std::vector<uint8_t> bytes;
+        const int mode = random() % 3;
+        const int count = random() % 40;
+        for (int i = 0; i < count; i++) {
+            if (mode == 0) {
+                // Mostly small values, like geometry deltas.
+                const int bits = (random() % 8) ? random() % 8 : random() % 64;
+                encode(bytes, bits ? random() & ((uint64_t(1) << bits) - 1) : 0);
+            } else if (mode == 1) {
+                encode(bytes, (uint64_t(random()) << 32) | random());
+            } else {
+                // Arbitrary bytes, which may contain runs of continuation bits.
+                bytes.push_back(uint8_t(random() | ((random() % 2) ? 0x80 : 0)));
+            }
+        }
+
+        std::vector<uint32_t> scalar, batched, chunked;
+        const std::string scalarError = decodeScalar(bytes, scalar);
+        const std::string batchedError = decodeBatched(bytes, batched);
+        const std::string chunkedError = decodeChunked(bytes, 1 + random() % 12, chunked);
+        ASSERT_EQ(scalarError, batchedError) << "run " << run;
+        ASSERT_EQ(scalarError, chunkedError) << "run " << run;
+        if (scalarError.empty()) {
+            ASSERT_EQ(scalar, batched) << "run " << run;
+            ASSERT_EQ(scalar, chunked) << "run " << run;
+        }
+    }
+}
@@ -1,7 +1,19 @@
 #include <iostream>
 #include "../fixtures/util.hpp"
 
+#include <mbgl/map/shared_tile_store.hpp>
 #include <mbgl/map/tile_id.hpp>
+#include <mbgl/map/tile_key_set.hpp>
+#include <mbgl/map/tile_pyramid.hpp>
+#include <mbgl/map/vector_tile.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/space_filling_curve.hpp>
+#include <mbgl/util/tile_cover.hpp>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <unordered_set>
 
 using namespace mbgl;
 
@@ -48,3 +60,389 @@ TEST(Variant, isChild) {
     ASSERT_TRUE(TileID(3, -4, 0, 3).isChildOf(TileID(1, -1, 0, 1)));
     ASSERT_TRUE(TileID(3, -5, 0, 3).isChildOf(TileID(1, -2, 0, 1)));
 }
+
+TEST(TileID, Key) {
+    std::set<uint64_t> keys;
+    for (int8_t z = 0; z <= 4; z++) {
+        const int32_t dim = 1 << z;
+        for (int32_t x = -2 * dim; x < 2 * dim; x++) {
+            for (int32_t y = 0; y < dim; y++) {
+                const TileID id(z, x, y, z);
+                EXPECT_TRUE(keys.insert(id.key()).second);
+                const TileID decoded = TileID::fromKey(id.key());
+                EXPECT_EQ(id, decoded);
+                EXPECT_EQ(id.sourceZ, decoded.sourceZ);
+            }
+        }
+    }
+
+    // Overscaled tiles share x and y with their source tile, but not the key.
+    EXPECT_NE(TileID(14, 10, 20, 14).key(), TileID(15, 10, 20, 14).key());
+    EXPECT_NE(TileID(15, 10, 20, 15).key(), TileID(15, 10, 20, 14).key());
+    EXPECT_EQ(TileID(23, 8388607, 8388607, 23), TileID::fromKey(TileID(23, 8388607, 8388607, 23).key()));
+    EXPECT_EQ(TileID(22, -1, 5, 22), TileID::fromKey(TileID(22, -1, 5, 22).key()));
+}
+
+TEST(TileID, KeyRange) {
+    const TileID parent(2, 5, 3, 2);
+    const auto range = parent.keyRange(4, 4);
+    std::set<uint64_t> keys;
+    for (int8_t z = 0; z <= 5; z++) {
+        for (int32_t x = 0; x < (1 << z) * 2; x++) {
+            for (int32_t y = 0; y < (1 << z); y++) {
+                keys.insert(TileID(z, x, y, z).key());
+            }
+        }
+    }
+
+    auto it = keys.lower_bound(range.first);
+    const auto end = keys.lower_bound(range.second);
+    int count = 0;
+    for (; it != end; ++it, ++count) {
+        const TileID child = TileID::fromKey(*it);
+        EXPECT_EQ(4, child.z);
+        EXPECT_TRUE(child.isChildOf(parent));
+    }
+    EXPECT_EQ(16, count);
+
+    const auto overscaled = TileID(14, 10, 20, 14).keyRange(16, 14);
+    EXPECT_EQ(TileID(16, 10, 20, 14).key(), overscaled.first);
+    EXPECT_EQ(TileID(16, 10, 20, 14).key() + 1, overscaled.second);
+}
+
+TEST(TileID, HasKey) {
+    EXPECT_TRUE(TileID(0, 127, 0, 0).hasKey());
+    EXPECT_TRUE(TileID(0, -128, 0, 0).hasKey());
+    EXPECT_FALSE(TileID(0, 128, 0, 0).hasKey());
+    EXPECT_FALSE(TileID(0, -129, 0, 0).hasKey());
+    EXPECT_TRUE(TileID(2, 4 * 127 + 3, 0, 2).hasKey());
+    EXPECT_FALSE(TileID(2, 4 * 128, 0, 2).hasKey());
+    EXPECT_TRUE(TileID(25, 0, 0, 23).hasKey());
+    EXPECT_FALSE(TileID(24, 0, 0, 24).hasKey());
+}
+
+TEST(TileID, Hash) {
+    // Tiles that compare equal hash equally, even if their source zoom levels differ.
+    const TileID::Hash hash;
+    EXPECT_EQ(TileID(16, 10, 20, 14), TileID(16, 10, 20, 16));
+    EXPECT_EQ(hash(TileID(16, 10, 20, 14)), hash(TileID(16, 10, 20, 16)));
+
+    std::unordered_set<TileID, TileID::Hash> ids { TileID(16, 10, 20, 14) };
+    EXPECT_EQ(1u, ids.count(TileID(16, 10, 20, 16)));
+    EXPECT_EQ(0u, ids.count(TileID(16, 11, 20, 14)));
+}
+
+TEST(TileID, SpaceFillingCurves) {
+    EXPECT_EQ(0u, util::mortonEncode(0, 0));
+    EXPECT_EQ(1u, util::mortonEncode(1, 0));
+    EXPECT_EQ(2u, util::mortonEncode(0, 1));
+    EXPECT_EQ(3u, util::mortonEncode(1, 1));
+    EXPECT_EQ(util::mortonEncode(3, 5) * 4 + 3, util::mortonEncode(7, 11));
+
+    const uint8_t z = 5;
+    std::set<uint64_t> indices;
+    for (uint32_t x = 0; x < (1u << z); x++) {
+        for (uint32_t y = 0; y < (1u << z); y++) {
+            const auto morton = util::mortonDecode(util::mortonEncode(x, y));
+            EXPECT_EQ(x, morton.first);
+            EXPECT_EQ(y, morton.second);
+
+            const uint64_t index = util::hilbertEncode(z, x, y);
+            EXPECT_LT(index, 1u << (2 * z));
+            EXPECT_TRUE(indices.insert(index).second);
+            const auto hilbert = util::hilbertDecode(z, index);
+            EXPECT_EQ(x, hilbert.first);
+            EXPECT_EQ(y, hilbert.second);
+        }
+    }
+
+    // Consecutive Hilbert indices are adjacent tiles.
+    for (uint64_t i = 1; i < (1u << (2 * z)); i++) {
+        const auto a = util::hilbertDecode(z, i - 1);
+        const auto b = util::hilbertDecode(z, i);
+        EXPECT_EQ(1, std::abs(int(a.first) - int(b.first)) + std::abs(int(a.second) - int(b.second)));
+    }
+}
+
+TEST(TileKeySet, InsertAndClear) {
+    TileKeySet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.has(0));
+
+    for (uint64_t key = 0; key < 1000; key++) {
+        EXPECT_TRUE(set.insert(key * 31));
+    }
+    EXPECT_FALSE(set.insert(31));
+    EXPECT_EQ(1000u, set.size());
+
+    for (uint64_t key = 0; key < 1000; key++) {
+        EXPECT_TRUE(set.has(key * 31));
+        EXPECT_FALSE(set.has(key * 31 + 1));
+    }
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.has(31));
+    EXPECT_TRUE(set.insert(31));
+    EXPECT_TRUE(set.has(31));
+}
+
+TEST(TilePyramid, Ancestors) {
+    TilePyramid pyramid;
+    pyramid.add(TileID(3, 5, 2, 3), 14);
+    pyramid.add(TileID(16, 100, 200, 14), 14);
+
+    EXPECT_TRUE(pyramid.isReady(TileID(3, 5, 2, 3)));
+    EXPECT_FALSE(pyramid.isReady(TileID(2, 2, 1, 2)));
+    EXPECT_FALSE(pyramid.hasReadyDescendants(TileID(3, 5, 2, 3)));
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(2, 2, 1, 2)));
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(1, 1, 0, 1)));
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(0, 0, 0, 0)));
+    EXPECT_FALSE(pyramid.hasReadyDescendants(TileID(2, 3, 1, 2)));
+
+    // Overscaled tiles keep their coordinates above the source's maximum zoom level.
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(15, 100, 200, 14)));
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(14, 100, 200, 14)));
+    EXPECT_TRUE(pyramid.hasReadyDescendants(TileID(13, 50, 100, 13)));
+    EXPECT_FALSE(pyramid.hasReadyDescendants(TileID(16, 100, 200, 14)));
+
+    pyramid.clear();
+    EXPECT_FALSE(pyramid.isReady(TileID(3, 5, 2, 3)));
+    EXPECT_FALSE(pyramid.hasReadyDescendants(TileID(0, 0, 0, 0)));
+}
+
+TEST(TileCover, SortedByDistance) {
+    box bounds;
+    bounds.tl = { 0.5, 0.5 };
+    bounds.tr = { 3.5, 0.5 };
+    bounds.bl = { 0.5, 2.5 };
+    bounds.br = { 3.5, 2.5 };
+    bounds.center = { 2, 1.5 };
+
+    std::vector<CoveredTile> cover;
+    tileCover(3, bounds, cover);
+    ASSERT_EQ(12u, cover.size());
+
+    std::set<std::pair<int32_t, int32_t>> unique;
+    for (std::size_t i = 0; i < cover.size(); i++) {
+        EXPECT_TRUE(unique.emplace(cover[i].x, cover[i].y).second);
+        EXPECT_GE(cover[i].x, 0);
+        EXPECT_LE(cover[i].x, 3);
+        EXPECT_GE(cover[i].y, 0);
+        EXPECT_LE(cover[i].y, 2);
+        if (i > 0) {
+            EXPECT_LE(cover[i - 1].distance, cover[i].distance);
+        }
+    }
+
+    // The vector is refilled, not appended to.
+    tileCover(3, bounds, cover);
+    EXPECT_EQ(12u, cover.size());
+}
+
+TEST(TileCover, WithinWorldRows) {
+    // A view that extends past the top and the bottom of the world at z1.
+    box bounds;
+    bounds.tl = { 0.5, -1.5 };
+    bounds.tr = { 1.5, -1.5 };
+    bounds.bl = { 0.5, 3.5 };
+    bounds.br = { 1.5, 3.5 };
+    bounds.center = { 1, 1 };
+
+    std::vector<CoveredTile> cover;
+    tileCover(1, bounds, cover);
+    ASSERT_EQ(4u, cover.size());
+    for (const auto& tile : cover) {
+        EXPECT_LE(0, tile.y);
+        EXPECT_GT(2, tile.y);
+    }
+}
+
+namespace {
+
+// A square of size * size tiles at zoom level z, sorted by distance from its center.
+std::vector<CoveredTile> squareCover(int8_t z, int32_t size) {
+    box bounds;
+    bounds.tl = { 0, 0 };
+    bounds.tr = { double(size), 0 };
+    bounds.bl = { 0, double(size) };
+    bounds.br = { double(size), double(size) };
+    bounds.center = { size / 2.0, size / 2.0 };
+
+    std::vector<CoveredTile> cover;
+    tileCover(z, bounds, cover);
+    return cover;
+}
+
+bool contains(const TileID& parent, const TileID& id) {
+    return parent == id || id.isChildOf(parent);
+}
+
+}
+
+TEST(LODCover, CoversEveryTileOnce) {
+    const auto cover = squareCover(6, 16);
+    ASSERT_EQ(256u, cover.size());
+
+    LODCover lodCover;
+    std::vector<TileID> ids;
+    lodCover.build(cover, { 8, 8 }, 2, 0, 3, 6, 6, ids);
+
+    // Far tiles are lowered, but not by more than maxDrop levels.
+    EXPECT_GT(cover.size(), ids.size());
+    for (const auto& id : ids) {
+        EXPECT_LE(3, id.z);
+        EXPECT_GE(6, id.z);
+    }
+
+    // No tile overlaps another.
+    for (const auto& a : ids) {
+        for (const auto& b : ids) {
+            if (!(a == b)) {
+                EXPECT_FALSE(contains(a, b)) << std::string(a) << " overlaps " << std::string(b);
+            }
+        }
+    }
+
+    // Every tile of the cover is covered by exactly one tile.
+    for (const auto& tile : cover) {
+        const TileID id(6, tile.x, tile.y, 6);
+        EXPECT_EQ(1, std::count_if(ids.begin(), ids.end(), [&](const TileID& lowered) {
+            return contains(lowered, id);
+        })) << std::string(id);
+    }
+
+    // The tiles at the center keep the ideal zoom level and come first.
+    EXPECT_EQ(6, ids.front().z);
+}
+
+TEST(LODCover, KeepsSiblingsOfDetailedTiles) {
+    // The second tile is far enough from the center to be lowered to z0, but that tile would
+    // contain the first one. Both would be rendered, and their symbols placed twice.
+    const std::vector<CoveredTile> cover = { { 0, 0, 0 }, { 1, 0, 1 } };
+
+    LODCover lodCover;
+    std::vector<TileID> ids;
+    lodCover.build(cover, { 0.5, 0.5 }, 0.6, 0, 1, 1, 1, ids);
+    EXPECT_EQ(std::vector<TileID>({ TileID(1, 0, 0, 1), TileID(1, 1, 0, 1) }), ids);
+
+    // Once neither keeps detail, they're merged into their parent.
+    lodCover.build(cover, { 0.5, 0.5 }, 0, 0, 1, 1, 1, ids);
+    EXPECT_EQ(std::vector<TileID>({ TileID(0, 0, 0, 0) }), ids);
+}
+
+TEST(LODCover, Budget) {
+    const auto cover = squareCover(6, 16);
+
+    LODCover lodCover;
+    std::vector<TileID> ids;
+
+    // The radius covers the whole square, so no tile is lowered without a budget.
+    lodCover.build(cover, { 8, 8 }, 16, 0, 4, 6, 6, ids);
+    EXPECT_EQ(256u, ids.size());
+
+    for (const std::size_t budget : { 200u, 64u, 20u }) {
+        lodCover.build(cover, { 8, 8 }, 16, budget, 4, 6, 6, ids);
+        EXPECT_GE(budget, ids.size());
+        EXPECT_LT(0u, ids.size());
+    }
+
+    // A budget that can't be met lowers all tiles as far as allowed.
+    lodCover.build(cover, { 8, 8 }, 16, 1, 1, 6, 6, ids);
+    EXPECT_EQ(64u, ids.size());
+}
+
+TEST(LODCover, Overscaled) {
+    // Tiles at z4 are overscaled from z2. They keep their coordinates down to z2.
+    const std::vector<CoveredTile> cover = { { 0, 0, 0 }, { 1, 0, 1 } };
+
+    LODCover lodCover;
+    std::vector<TileID> ids;
+    lodCover.build(cover, { 0.5, 0.5 }, 0, 0, 2, 2, 4, ids);
+    EXPECT_EQ(std::vector<TileID>({ TileID(2, 0, 0, 2), TileID(2, 1, 0, 2) }), ids);
+
+    lodCover.build(cover, { 0.5, 0.5 }, 0, 0, 3, 2, 4, ids);
+    EXPECT_EQ(std::vector<TileID>({ TileID(1, 0, 0, 1) }), ids);
+}
+
+TEST(SharedVectorTile, DecodesOnce) {
+    const SharedVectorTile tile(util::read_file("test/fixtures/resources/vector.pbf"));
+
+    std::vector<std::shared_ptr<const VectorTile>> decoded(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < decoded.size(); i++) {
+        threads.emplace_back([&tile, &decoded, i] {
+            decoded[i] = tile.get();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& result : decoded) {
+        EXPECT_EQ(tile.get(), result);
+    }
+
+    const auto layer = tile.get()->getLayer("hillshade");
+    ASSERT_TRUE(bool(layer));
+    EXPECT_LT(0u, layer->featureCount());
+    EXPECT_FALSE(bool(tile.get()->getLayer("nonexistent")));
+}
+
+TEST(SharedVectorTile, Release) {
+    const SharedVectorTile tile(util::read_file("test/fixtures/resources/vector.pbf"));
+
+    std::weak_ptr<const VectorTile> first = tile.get();
+    EXPECT_FALSE(first.expired());
+
+    // Callers that still hold the decoded tile keep it alive.
+    const auto held = tile.get();
+    tile.release();
+    EXPECT_FALSE(first.expired());
+
+    const auto second = tile.get();
+    EXPECT_NE(held, second);
+    ASSERT_TRUE(bool(second->getLayer("hillshade")));
+
+    tile.release();
+    std::weak_ptr<const VectorTile> third = tile.get();
+    tile.release();
+    EXPECT_TRUE(third.expired());
+}
+
+TEST(SharedVectorTile, MemoryShare) {
+    const std::string data = util::read_file("test/fixtures/resources/vector.pbf");
+    const SharedVectorTile tile(data);
+    tile.addHolder();
+    EXPECT_EQ(data.size(), tile.getMemoryShare());
+
+    // The decoded tile counts while it is kept.
+    auto decoded = tile.get();
+    EXPECT_LT(0u, decoded->getMemorySize());
+    EXPECT_EQ(data.size() + decoded->getMemorySize(), tile.getMemoryShare());
+    decoded.reset();
+    tile.release();
+    EXPECT_EQ(data.size(), tile.getMemoryShare());
+
+    // Holders in two Maps count half each.
+    tile.addHolder();
+    EXPECT_EQ(data.size() / 2, tile.getMemoryShare());
+    tile.removeHolder();
+    tile.removeHolder();
+}
+
+TEST(SharedTileStore, ExpiresUnreferencedTiles) {
+    auto& store = SharedTileStore::get();
+    const std::string url = "test://tiles/1/0/0.pbf";
+
+    EXPECT_FALSE(bool(store.find(url)));
+
+    auto tile = std::make_shared<const SharedVectorTile>("");
+    store.add(url, tile);
+    EXPECT_EQ(tile, store.find(url));
+    EXPECT_EQ(1u, store.size());
+
+    tile.reset();
+    EXPECT_FALSE(bool(store.find(url)));
+    EXPECT_EQ(0u, store.size());
+}
@@ -0,0 +1,106 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/renderer/tile_render_cache.hpp>
+#include <mbgl/util/gl_object_store.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Makes an OpenGL context current on this thread for as long as it exists.
+class TestContext {
+public:
+    TestContext() {
+        view.activate();
+        util::ThreadContext::setGLObjectStore(&glObjectStore);
+    }
+
+    ~TestContext() {
+        glObjectStore.performCleanup();
+        util::ThreadContext::setGLObjectStore(nullptr);
+        view.deactivate();
+    }
+
+private:
+    std::shared_ptr<HeadlessDisplay> display = std::make_shared<HeadlessDisplay>();
+    HeadlessView view { display, 1 };
+    util::GLObjectStore glObjectStore;
+};
+
+TileRenderCache::Key key(int32_t x, uint64_t revision = 1) {
+    return { TileID(1, x, 0, 1), 1, 42, revision };
+}
+
+void render(TileRenderCache& cache, const TileRenderCache::Key& key_) {
+    cache.beginRender(key_, 64, 64);
+    cache.endRender();
+}
+
+}
+
+TEST(TileRenderCache, Hit) {
+    TestContext context;
+    TileRenderCache cache(2);
+
+    EXPECT_EQ(nullptr, cache.get(key(0)));
+    render(cache, key(0));
+
+    const auto texture = cache.get(key(0));
+    ASSERT_NE(nullptr, texture);
+    EXPECT_NE(0u, texture->texture);
+    EXPECT_EQ(64, texture->width);
+    EXPECT_EQ(64, texture->height);
+}
+
+TEST(TileRenderCache, Miss) {
+    TestContext context;
+    TileRenderCache cache(4);
+    render(cache, key(0));
+
+    EXPECT_EQ(nullptr, cache.get(key(1)));
+    EXPECT_EQ(nullptr, cache.get({ TileID(1, 0, 0, 1), 2, 42, 1 }));
+    EXPECT_EQ(nullptr, cache.get({ TileID(1, 0, 0, 1), 1, 43, 1 }));
+    EXPECT_NE(nullptr, cache.get(key(0)));
+}
+
+TEST(TileRenderCache, Invalidation) {
+    TestContext context;
+    TileRenderCache cache(4);
+    render(cache, key(0, 1));
+    render(cache, key(1, 1));
+
+    // A reparsed tile has a new revision, so its old render is no longer used.
+    EXPECT_EQ(nullptr, cache.get(key(0, 2)));
+    render(cache, key(0, 2));
+    EXPECT_NE(nullptr, cache.get(key(0, 2)));
+    EXPECT_NE(nullptr, cache.get(key(1, 1)));
+
+    cache.clear();
+    EXPECT_EQ(nullptr, cache.get(key(0, 2)));
+    EXPECT_EQ(nullptr, cache.get(key(1, 1)));
+
+    // Only the shared depth buffer remains.
+    EXPECT_EQ(64u * 64 * 2, cache.getMemoryFootprint().gpu);
+}
+
+TEST(TileRenderCache, Eviction) {
+    TestContext context;
+    TileRenderCache cache(2);
+    render(cache, key(0));
+    render(cache, key(1));
+
+    // Looking up a tile makes it the most recently used one.
+    EXPECT_NE(nullptr, cache.get(key(0)));
+    render(cache, key(2));
+    EXPECT_NE(nullptr, cache.get(key(0)));
+    EXPECT_EQ(nullptr, cache.get(key(1)));
+    EXPECT_NE(nullptr, cache.get(key(2)));
+
+    cache.setSize(1);
+    EXPECT_EQ(nullptr, cache.get(key(0)));
+    EXPECT_NE(nullptr, cache.get(key(2)));
+    EXPECT_EQ(1u * 64 * 64 * 4 + 64 * 64 * 2, cache.getMemoryFootprint().gpu);
+}
@@ -0,0 +1,153 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/trace.hpp>
+
+#include <rapidjson/document.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace mbgl;
+
+namespace {
+
+rapidjson::Document exportTrace() {
+    const std::string json = trace::exportChromeTrace();
+    rapidjson::Document document;
+    document.Parse<0>(json.c_str());
+    EXPECT_FALSE(document.HasParseError()) << json;
+    return document;
+}
+
+std::size_t countEvents(const rapidjson::Document& document, const char* name, const char* phase) {
+    std::size_t count = 0;
+    const auto& events = document["traceEvents"];
+    for (rapidjson::SizeType i = 0; i < events.Size(); i++) {
+        if (std::strcmp(events[i]["name"].GetString(), name) == 0 &&
+            std::strcmp(events[i]["ph"].GetString(), phase) == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}
+
+TEST(Trace, ChromeTraceExport) {
+    // Not recorded, since recording didn't start yet.
+    { const trace::Scope scope("test", "before"); }
+
+    trace::start();
+    {
+        const trace::Scope scope("test", "outer");
+        { const trace::Scope inner("test", "inner"); }
+        trace::instant("test", "instant");
+    }
+
+    int request = 0;
+    trace::asyncBegin("test", "async", &request);
+    std::thread([&] {
+        const trace::Scope scope("test", "thread");
+        trace::asyncEnd("test", "async", &request);
+    }).join();
+    trace::stop();
+
+    // Not recorded, since recording stopped.
+    { const trace::Scope scope("test", "after"); }
+
+    const auto document = exportTrace();
+    ASSERT_TRUE(document.IsObject());
+    ASSERT_TRUE(document["traceEvents"].IsArray());
+
+    EXPECT_EQ(0u, countEvents(document, "before", "X"));
+    EXPECT_EQ(1u, countEvents(document, "outer", "X"));
+    EXPECT_EQ(1u, countEvents(document, "inner", "X"));
+    EXPECT_EQ(1u, countEvents(document, "instant", "i"));
+    EXPECT_EQ(1u, countEvents(document, "async", "b"));
+    EXPECT_EQ(1u, countEvents(document, "async", "e"));
+    EXPECT_EQ(1u, countEvents(document, "thread", "X"));
+    EXPECT_EQ(0u, countEvents(document, "after", "X"));
+
+    // Every thread that recorded events is named, the main thread by its context.
+    EXPECT_LE(2u, countEvents(document, "thread_name", "M"));
+
+    const auto& events = document["traceEvents"];
+    uint64_t outerThread = 0, threadThread = 0;
+    for (rapidjson::SizeType i = 0; i < events.Size(); i++) {
+        const auto& event = events[i];
+        const std::string name = event["name"].GetString();
+        if (name == "outer") {
+            outerThread = event["tid"].GetUint();
+            EXPECT_TRUE(event["dur"].IsNumber());
+        } else if (name == "thread") {
+            threadThread = event["tid"].GetUint();
+        } else if (name == "async") {
+            EXPECT_TRUE(event["id"].IsString());
+        }
+    }
+    EXPECT_NE(outerThread, threadThread);
+
+    for (rapidjson::SizeType i = 0; i < events.Size(); i++) {
+        const auto& event = events[i];
+        if (std::string("thread_name") == event["name"].GetString() && event["tid"].GetUint() == outerThread) {
+            EXPECT_EQ(std::string("Main"), event["args"]["name"].GetString());
+        }
+    }
+}
+
+TEST(Trace, RingBuffer) {
+    trace::start(4);
+    for (int i = 0; i < 10; i++) {
+        trace::instant("test", "event");
+    }
+    trace::instant("test", "last");
+    trace::stop();
+
+    // Only the most recent events are kept.
+    const auto document = exportTrace();
+    EXPECT_EQ(3u, countEvents(document, "event", "i"));
+    EXPECT_EQ(1u, countEvents(document, "last", "i"));
+}
+
+TEST(Trace, ReusesBuffersOfExitedThreads) {
+    trace::start(4);
+    for (int i = 0; i < 8; i++) {
+        std::thread([] { trace::instant("test", "worker"); }).join();
+    }
+    trace::stop();
+
+    // Each thread took over the buffer of the one before, and only the last one's event is kept.
+    const auto recorded = exportTrace();
+    EXPECT_EQ(1u, countEvents(recorded, "worker", "i"));
+    const std::size_t threads = countEvents(recorded, "thread_name", "M");
+    EXPECT_GE(2u, threads);
+
+    // Restarting frees the buffers of exited threads.
+    trace::start(4);
+    trace::stop();
+    const auto restarted = exportTrace();
+    EXPECT_EQ(0u, countEvents(restarted, "worker", "i"));
+    EXPECT_EQ(threads - 1, countEvents(restarted, "thread_name", "M"));
+}
+
+TEST(Trace, ExportWhileRecording) {
+    trace::start(64);
+    std::atomic<bool> done { false };
+    std::thread thread([&] {
+        for (int i = 0; i < 100000; i++) {
+            trace::instant("test", "busy");
+        }
+        done = true;
+    });
+
+    while (!done) {
+        const auto document = exportTrace();
+        EXPECT_GE(64u, countEvents(document, "busy", "i"));
+    }
+
+    thread.join();
+    trace::stop();
+
+    EXPECT_EQ(64u, countEvents(exportTrace(), "busy", "i"));
+}
@@ -0,0 +1,108 @@
+#include "../fixtures/util.hpp"
+#include "replay_file_source.hpp"
+
+#include <mbgl/util/io.hpp>
+
+#include <uv.h>
+
+#include <cstdio>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<const Response> makeResponse(Response::Status status, const std::string& data) {
+    auto response = std::make_shared<Response>();
+    response->status = status;
+    response->data = data;
+    return response;
+}
+
+// Requests the URL and runs the loop until the response arrived.
+std::string load(FileSource& fileSource, const std::string& url) {
+    std::string result;
+    fileSource.request({ Resource::Tile, url }, uv_default_loop(), [&](const Response& res) {
+        result = res.status == Response::Successful ? res.data : "error: " + res.message;
+    });
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    return result;
+}
+
+}
+
+TEST(Replay, ArchiveRoundTrip) {
+    auto response = std::make_shared<Response>();
+    response->status = Response::Successful;
+    response->modified = 1420070400;
+    response->expires = 1420074000;
+    response->etag = "\"v1\"";
+    response->data = std::string("\x1a\x00\xff tile", 8);
+
+    auto error = std::make_shared<Response>();
+    error->message = "HTTP status code 404";
+
+    ReplayArchive archive;
+    archive.entries.push_back({ Resource::Tile, "http://example.com/0/0/0.pbf", std::chrono::microseconds(25000), response });
+    archive.entries.push_back({ Resource::Glyphs, "http://example.com/fonts/0-255.pbf", std::chrono::microseconds(3), error });
+
+    const std::string path = "test/fixtures/storage/replay.archive";
+    archive.save(path);
+    const ReplayArchive loaded = ReplayArchive::load(path);
+
+    ASSERT_EQ(2u, loaded.entries.size());
+    for (std::size_t i = 0; i < loaded.entries.size(); i++) {
+        const auto& expected = archive.entries[i];
+        const auto& actual = loaded.entries[i];
+        EXPECT_EQ(expected.kind, actual.kind);
+        EXPECT_EQ(expected.url, actual.url);
+        EXPECT_EQ(expected.latency, actual.latency);
+        EXPECT_EQ(expected.response->status, actual.response->status);
+        EXPECT_EQ(expected.response->modified, actual.response->modified);
+        EXPECT_EQ(expected.response->expires, actual.response->expires);
+        EXPECT_EQ(expected.response->etag, actual.response->etag);
+        EXPECT_EQ(expected.response->message, actual.response->message);
+        EXPECT_EQ(expected.response->data, actual.response->data);
+    }
+
+    // Truncated archives and other files are rejected.
+    const std::string data = util::read_file(path);
+    util::write_file(path, data.substr(0, data.size() - 1));
+    EXPECT_THROW(ReplayArchive::load(path), std::runtime_error);
+    util::write_file(path, "MBGLREC0");
+    EXPECT_THROW(ReplayArchive::load(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(Replay, FileSource) {
+    ReplayArchive archive;
+    archive.entries.push_back({ Resource::Tile, "a", Duration::zero(), makeResponse(Response::Successful, "a1") });
+    archive.entries.push_back({ Resource::Tile, "b", Duration::zero(), makeResponse(Response::Successful, "b1") });
+    archive.entries.push_back({ Resource::Tile, "a", Duration::zero(), makeResponse(Response::Successful, "a2") });
+
+    ReplayFileSource fileSource(archive, 0);
+
+    // Responses come in the recorded order, and the last one repeats.
+    EXPECT_EQ("a1", load(fileSource, "a"));
+    EXPECT_EQ("a2", load(fileSource, "a"));
+    EXPECT_EQ("a2", load(fileSource, "a"));
+    EXPECT_EQ("b1", load(fileSource, "b"));
+    EXPECT_EQ("error: Not in the replay archive", load(fileSource, "c"));
+
+    // Every run replays the archive from the start.
+    fileSource.rewind();
+    EXPECT_EQ("a1", load(fileSource, "a"));
+    EXPECT_EQ("b1", load(fileSource, "b"));
+    EXPECT_EQ("a2", load(fileSource, "a"));
+}
+
+TEST(Replay, Latency) {
+    ReplayArchive archive;
+    archive.entries.push_back({ Resource::Tile, "a", std::chrono::milliseconds(20), makeResponse(Response::Successful, "a") });
+
+    ReplayFileSource fileSource(archive, 2.0);
+
+    const TimePoint start = Clock::now();
+    EXPECT_EQ("a", load(fileSource, "a"));
+    EXPECT_LE(std::chrono::milliseconds(40), Clock::now() - start);
+}